@@ -0,0 +1,88 @@
+/*************************************************************
+ * File: pqueue-alloccount.cpp
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * Replacements for the global operator new and operator delete that keep
+ * a running count of allocations and frees. Memory still comes from malloc.
+ */
+
+#include "pqueue-alloccount.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// number of allocations so far; atomic so that threads can share it
+static std::atomic<long> numAllocations(0);
+
+// number of blocks freed so far
+static std::atomic<long> numFrees(0);
+
+/*
+ * Return the number of allocations made so far.
+ */
+long allocationCount() {
+    return numAllocations.load(std::memory_order_relaxed);
+}
+
+/*
+ * Return the number of allocations not freed yet.
+ */
+long liveAllocationCount() {
+    return numAllocations.load(std::memory_order_relaxed) - numFrees.load(std::memory_order_relaxed);
+}
+
+/*
+ * Count an allocation and hand back memory from malloc. Like the standard
+ *   operator new, a zero-byte request still returns a unique pointer.
+ */
+static void* countedAllocate(std::size_t size) {
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    return memory;
+}
+
+void* operator new(std::size_t size) {
+    void* memory = countedAllocate(size);
+    if (memory == NULL) throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new[](std::size_t size) {
+    void* memory = countedAllocate(size);
+    if (memory == NULL) throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) throw() {
+    return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) throw() {
+    return countedAllocate(size);
+}
+
+/*
+ * Count a free, unless of a null pointer, and hand the memory back.
+ */
+static void countedFree(void* memory) {
+    if (memory != NULL) numFrees.fetch_add(1, std::memory_order_relaxed);
+    std::free(memory);
+}
+
+void operator delete(void* memory) throw() {
+    countedFree(memory);
+}
+
+void operator delete[](void* memory) throw() {
+    countedFree(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) throw() {
+    countedFree(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) throw() {
+    countedFree(memory);
+}
@@ -0,0 +1,24 @@
+/**********************************************
+ * File: pqueue-alloccount.h
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * Counts the heap allocations made by the program. Linking in
+ * pqueue-alloccount.cpp replaces the global operator new so that the
+ * speed tests can report how many allocations each priority queue makes.
+ */
+#ifndef PQueue_AllocCount_Included
+#define PQueue_AllocCount_Included
+
+/* Returns the number of times operator new has been called since the
+ * program started.
+ */
+long allocationCount();
+
+/* Returns the number of blocks allocated with operator new that have not
+ * been freed yet.
+ */
+long liveAllocationCount();
+
+#endif
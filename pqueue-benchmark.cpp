@@ -0,0 +1,580 @@
+/*************************************************************
+ * File: pqueue-benchmark.cpp
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * A standalone benchmark of the priority queue classes, built as its own
+ * target so that it can be compiled with optimization while the test
+ * harness is not.
+ *
+ * For every queue and every size from 10 up to 10,000,000 values, three
+ * phases are timed separately: enqueuing the values into an empty queue,
+ * dequeuing them all from a full queue, and a mixed phase on a full queue
+ * in which each dequeued value is enqueued again with a random increment
+ * added. The mixed phase is the classic hold model: it keeps the size of
+ * the queue steady, and the values it enqueues never fall below the
+ * smallest one, which the radix queue relies on. Only the queue
+ * operations are timed; generating the values and filling the queue for
+ * the later phases is done before the stopwatch starts.
+ *
+ * Small queues are timed in batches of many queues, so that each
+ * repetition runs long enough for steady_clock to measure it. Each phase
+ * is run once to warm up, then repeated enough times to fill about
+ * TARGET_SECONDS, and reported as the median and the 99th percentile time
+ * per operation. Comparing rows for the same phase across sizes shows
+ * where one implementation overtakes another. The concurrent queues are
+ * driven from a single thread, so their rows show what their locking costs
+ * when no other thread is contending.
+ *
+ * Each row also gives the heap allocations per operation over the timed
+ * repetitions, counted by the operator new in pqueue-alloccount.cpp. If
+ * asked to, the sweep also reads the hardware counters of
+ * pqueue-perfcounters.h around the timed part of each repetition, and adds
+ * instructions, L1 and last level cache misses and branch mispredictions
+ * per operation.
+ *
+ * Before that sweep, every queue runs the same realistic workloads from
+ * pqueue-workload.h: the hold model at several sizes, Dijkstra's
+ * algorithm on a random graph, and the replay of a trace. Their results
+ * are written as CSV, so that runs can be kept and compared over time.
+ *
+ * Instead of timing anything, the benchmark can also fill every queue with
+ * a million values and print the bytes each value costs, split by the
+ * queue's memoryUsage() into the value itself and the overhead of holding
+ * it, for sizing a queue against a memory budget.
+ */
+
+#include "pqueue-vector.h"
+#include "pqueue-linkedlist.h"
+#include "pqueue-doublylinkedlist.h"
+#include "pqueue-heap.h"
+#include "pqueue-fibonacciheap.h"
+#include "pqueue-skiplist.h"
+#include "pqueue-pairingheap.h"
+#include "pqueue-radix.h"
+#include "pqueue-lockfreeskiplist.h"
+#include "pqueue-concurrentheap.h"
+#include "pqueue-multiqueue.h"
+#include "pqueue-workstealing.h"
+#include "pqueue-benchmark.h"
+#include "pqueue-workload.h"
+#include "pqueue-perfcounters.h"
+#include "pqueue-alloccount.h"
+#include "simpio.h"
+#include "strlib.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>    // For setw
+#include <cctype>     // For tolower
+#include <string>
+#include <vector>
+#include <algorithm>  // For sort
+#include <functional> // For less, greater
+#include <random>     // For minstd_rand
+using namespace std;
+
+// largest size benchmarked unless another one is asked for
+const int DEFAULT_MAX_SIZE = 10000000;
+
+// queues that take time linear in their size for some operation are only
+//   benchmarked up to this size
+const int LINEAR_QUEUE_MAX_SIZE = 10000;
+
+// smallest number of values handled by one repetition; smaller queues are
+//   timed in batches
+const int MIN_VALUES_PER_REPETITION = 100000;
+
+// time to spend on the repetitions of one phase, and bounds on their number
+const double TARGET_SECONDS = 0.25;
+const int MIN_REPETITIONS = 5;
+const int MAX_REPETITIONS = 101;
+
+// hold steps timed by one repetition of the hold model, on full size and
+//   on linear queues
+const int HOLD_OPERATIONS = 1000000;
+const int LINEAR_HOLD_OPERATIONS = 100000;
+
+// shape of the random graph for Dijkstra's algorithm
+const int GRAPH_MAX_VERTICES = 1000000;
+const int GRAPH_DEGREE = 4;
+const int GRAPH_MAX_WEIGHT = 1000;
+
+// number of values in every queue measured by the memory report
+const int MEMORY_REPORT_SIZE = 1000000;
+
+/* Type: Phase
+ * ------------------------------------------------------------
+ * The part of a queue's work that one benchmark times.
+ */
+enum Phase {
+    ENQUEUE,
+    DEQUEUE,
+    MIXED
+};
+
+/*
+ * Function: phaseName
+ * ------------------------------------------------------------
+ * Return the name printed for a phase.
+ */
+string phaseName(Phase phase) {
+    switch (phase) {
+    case ENQUEUE: return "enqueue";
+    case DEQUEUE: return "dequeue";
+    default:      return "mixed";
+    }
+}
+
+/*
+ * Function: randomValues
+ * ------------------------------------------------------------
+ * Return count random integers below limit from a generator with the
+ *   given seed, so that every queue is benchmarked on the same values.
+ */
+vector<int> randomValues(int count, int seed, int limit) {
+    minstd_rand random(seed);
+    vector<int> values(count);
+    for (int i = 0; i < count; i++) {
+        values[i] = int(random() % limit);
+    }
+    return values;
+}
+
+/* Type: PhaseCounters
+ * ------------------------------------------------------------
+ * Totals kept over every timed repetition of a phase: the hardware
+ * counters, or NULL if they are not read, the allocations made and the
+ * operations done.
+ */
+struct PhaseCounters {
+    PerfCounters* perf;
+    long allocations;
+    long operations;
+};
+
+/*
+ * Function: timePhase
+ * ------------------------------------------------------------
+ * Time one repetition of a phase on numQueues queues of values.size()
+ *   values each, and return the seconds taken. The queues are created,
+ *   filled if the phase needs it, and destroyed outside the timed part.
+ *   increments supplies the amounts added by the mixed phase. The timed
+ *   part is added to counters.
+ */
+template <typename PQueue>
+double timePhase(Phase phase, const vector<int>& values, const vector<int>& increments, int numQueues,
+                 PhaseCounters& counters) {
+    vector<PQueue> queues(numQueues);
+    if (phase != ENQUEUE) {
+        for (int q = 0; q < numQueues; q++) {
+            for (size_t i = 0; i < values.size(); i++) {
+                queues[q].enqueue(values[i]);
+            }
+        }
+    }
+
+    long checksum = 0;
+    long allocationsBefore = allocationCount();
+    if (counters.perf != NULL) counters.perf->start();
+    Stopwatch stopwatch;
+    for (int q = 0; q < numQueues; q++) {
+        PQueue& queue = queues[q];
+        switch (phase) {
+        case ENQUEUE:
+            for (size_t i = 0; i < values.size(); i++) {
+                queue.enqueue(values[i]);
+            }
+            break;
+        case DEQUEUE:
+            for (size_t i = 0; i < values.size(); i++) {
+                checksum += queue.dequeueMin();
+            }
+            break;
+        case MIXED:
+            for (size_t i = 0; i < increments.size(); i++) {
+                int value = queue.dequeueMin();
+                checksum += value;
+                queue.enqueue(value + increments[i]);
+            }
+            break;
+        }
+    }
+    double seconds = stopwatch.seconds();
+    if (counters.perf != NULL) counters.perf->stop();
+    counters.allocations += allocationCount() - allocationsBefore;
+    counters.operations += values.size() * numQueues * (phase == MIXED ? 2 : 1);
+    doNotOptimize(checksum);
+    return seconds;
+}
+
+/* Type: WorkloadSetup
+ * ------------------------------------------------------------
+ * Everything the workloads need that is made once and shared by all
+ * queues: the sizes to run the hold model at, the graph for Dijkstra's
+ * algorithm with the sum of its distances, and the trace to replay.
+ */
+struct WorkloadSetup {
+    vector<int> holdSizes;
+    int holdOperations;
+    RandomGraph graph;
+    long long dijkstraChecksum;
+    Trace trace;
+};
+
+/* Type: SingleWorkerQueue
+ * ------------------------------------------------------------
+ * Lets the workloads drive a WorkStealingPriorityQueue, whose operations
+ * take a worker, as a single worker.
+ */
+template <typename ValueType, typename KeyTraits>
+class SingleWorkerQueue {
+public:
+    SingleWorkerQueue() : queue(1) {}
+    int size() { return queue.size(); }
+    bool isEmpty() { return queue.isEmpty(); }
+    void enqueue(const ValueType& value) { queue.enqueue(0, value); }
+    ValueType dequeueMin() { return queue.dequeueMin(0); }
+    MemoryUsage memoryUsage() { return queue.memoryUsage(); }
+
+private:
+    WorkStealingPriorityQueue<ValueType, KeyTraits> queue;
+};
+
+/*
+ * Function: measure
+ * ------------------------------------------------------------
+ * Run sample, which times one repetition of a benchmark, once to warm up
+ *   and then as many times as fit in about TARGET_SECONDS, judging by the
+ *   warmup. afterWarmup is called in between, so that anything sample
+ *   counts can start again from the first timed repetition.
+ */
+template <typename Sample, typename AfterWarmup>
+BenchmarkStats measure(Sample sample, AfterWarmup afterWarmup) {
+    double warmupSeconds = sample();
+    afterWarmup();
+    int numRepetitions = int(min(double(MAX_REPETITIONS),
+                                 max(double(MIN_REPETITIONS), TARGET_SECONDS / warmupSeconds)));
+    return runRepetitions(0, numRepetitions, sample);
+}
+
+/*
+ * Function: measure
+ * ------------------------------------------------------------
+ * Run sample as above, for a benchmark that counts nothing.
+ */
+template <typename Sample>
+BenchmarkStats measure(Sample sample) {
+    return measure(sample, []() {});
+}
+
+/*
+ * Function: printHeader
+ * ------------------------------------------------------------
+ * Print the column headings of the phase sweep, with a column for each
+ *   hardware counter if perf is not NULL.
+ */
+void printHeader(PerfCounters* perf) {
+    cout << left << setw(28) << "Queue" << setw(9) << "Phase"
+         << right << setw(10) << "Size" << setw(12) << "Median ns" << setw(12) << "p99 ns"
+         << setw(6) << "Reps" << setw(10) << "allocs";
+    if (perf != NULL) {
+        for (int i = 0; i < NUM_PERF_COUNTERS; i++) {
+            cout << setw(10) << PerfCounters::name(PerfCounterKind(i));
+        }
+    }
+    cout << endl;
+}
+
+/*
+ * Function: printResult
+ * ------------------------------------------------------------
+ * Print one row of results. Times, allocations and counters are all per
+ *   operation; a counter that could not be opened, or that the kernel never
+ *   gave a turn to count, is shown as n/a.
+ */
+void printResult(string name, Phase phase, int size, BenchmarkStats stats, long numOperations,
+                 const PhaseCounters& counters) {
+    double nanosecondsPerOperation = 1e9 / numOperations;
+    cout << left << setw(28) << name << setw(9) << phaseName(phase)
+         << right << setw(10) << size
+         << fixed << setprecision(1)
+         << setw(12) << stats.median * nanosecondsPerOperation
+         << setw(12) << stats.p99 * nanosecondsPerOperation
+         << setw(6) << stats.repetitions
+         << setprecision(2) << setw(10) << double(counters.allocations) / counters.operations;
+    if (counters.perf != NULL) {
+        for (int i = 0; i < NUM_PERF_COUNTERS; i++) {
+            long long total = counters.perf->value(PerfCounterKind(i));
+            if (total < 0) {
+                cout << setw(10) << "n/a";
+            } else {
+                cout << setw(10) << double(total) / counters.operations;
+            }
+        }
+    }
+    cout << endl;
+    cout.unsetf(ios::fixed);
+}
+
+/*
+ * Function: benchmarkQueue
+ * ------------------------------------------------------------
+ * Benchmark every phase of one type of queue on sizes 10, 100 and so on
+ *   up to maxSize, reading the hardware counters if perf is not NULL.
+ *   The counters start again after the warmup, so that they cover the same
+ *   repetitions as the times they are printed next to.
+ */
+template <typename PQueue>
+void benchmarkQueue(string name, int maxSize, PerfCounters* perf) {
+    const Phase PHASES[] = { ENQUEUE, DEQUEUE, MIXED };
+    for (long size = 10; size <= maxSize; size *= 10) {
+        vector<int> values = randomValues(size, int(size), 1000000000);
+        vector<int> increments = randomValues(size, int(size) + 1, 1000000);
+        int numQueues = max(1L, MIN_VALUES_PER_REPETITION / size);
+
+        for (int p = 0; p < 3; p++) {
+            Phase phase = PHASES[p];
+            PhaseCounters counters = { perf, 0, 0 };
+            BenchmarkStats stats = measure([&]() {
+                return timePhase<PQueue>(phase, values, increments, numQueues, counters);
+            }, [&]() {
+                counters.allocations = 0;
+                counters.operations = 0;
+                if (perf != NULL) perf->reset();
+            });
+            long numOperations = size * numQueues * (phase == MIXED ? 2 : 1);
+            printResult(name, phase, int(size), stats, numOperations, counters);
+        }
+    }
+}
+
+/*
+ * Function: reportMemory
+ * ------------------------------------------------------------
+ * Fill one queue with values and print the bytes it takes per value, for
+ *   the values themselves, for the overhead of holding them, and in all.
+ */
+template <typename PQueue>
+void reportMemory(string name, const vector<int>& values) {
+    PQueue queue;
+    for (size_t i = 0; i < values.size(); i++) {
+        queue.enqueue(values[i]);
+    }
+    MemoryUsage usage = queue.memoryUsage();
+    double perValue = 1.0 / values.size();
+    cout << left << setw(28) << name
+         << right << fixed << setprecision(2)
+         << setw(12) << usage.payloadBytes * perValue
+         << setw(12) << usage.overheadBytes * perValue
+         << setw(12) << usage.totalBytes() * perValue << endl;
+    cout.unsetf(ios::fixed);
+}
+
+/*
+ * Function: runMemoryReport
+ * ------------------------------------------------------------
+ * Print the bytes per value of every queue holding MEMORY_REPORT_SIZE
+ *   random values. The sorted linked list is filled from the largest value
+ *   down, so that each value goes at its front and filling it takes linear
+ *   rather than quadratic time; it takes the same cells either way.
+ */
+void runMemoryReport() {
+    vector<int> values = randomValues(MEMORY_REPORT_SIZE, MEMORY_REPORT_SIZE, 1000000000);
+    vector<int> descending(values);
+    sort(descending.begin(), descending.end(), greater<int>());
+
+    cout << "Bytes per value in queues of " << MEMORY_REPORT_SIZE << " ints" << endl;
+    cout << left << setw(28) << "Queue"
+         << right << setw(12) << "Payload" << setw(12) << "Overhead" << setw(12) << "Total" << endl;
+    reportMemory<HeapPriorityQueue<int> >("Heap", values);
+    reportMemory<HeapPriorityQueue<int, less<int>, 4> >("4-ary Heap", values);
+    reportMemory<HeapPriorityQueue<int, less<int>, 4, true> >("4-ary Heap (cache aligned)", values);
+    reportMemory<PairingHeapPriorityQueue<int> >("Pairing Heap", values);
+    reportMemory<FibonacciHeapPriorityQueue<int> >("Fib Heap", values);
+    reportMemory<SkipListPriorityQueue<int> >("Skip List", values);
+    reportMemory<LockFreeSkipListPriorityQueue<int> >("Lock-Free Skip List", values);
+    reportMemory<RadixPriorityQueue<int, IntegerKey<int> > >("Radix Queue", values);
+    reportMemory<ConcurrentHeapPriorityQueue<int> >("Concurrent Heap", values);
+    reportMemory<MultiQueuePriorityQueue<int> >("MultiQueue", values);
+    reportMemory<SingleWorkerQueue<int, IntegerKey<int> > >("Work Stealing", values);
+    reportMemory<VectorPriorityQueue<int> >("Vector", values);
+    reportMemory<VectorPriorityQueue<int, less<int>, IntegerKey<int> > >("Vector (packed keys)", values);
+    reportMemory<LinkedListPriorityQueue<int> >("Linked List", descending);
+    reportMemory<DoublyLinkedListPriorityQueue<int> >("Double Linked List", values);
+}
+
+/*
+ * Function: makeWorkloadSetup
+ * ------------------------------------------------------------
+ * Make the workloads for queues of up to maxSize values. If trace is
+ *   empty, a trace of Dijkstra's algorithm on the graph is recorded and
+ *   replayed instead. A given trace that needs a larger queue is left out.
+ */
+WorkloadSetup makeWorkloadSetup(int maxSize, int holdOperations, const Trace& trace) {
+    WorkloadSetup setup;
+    for (int size = 100; size <= maxSize; size *= 100) {
+        setup.holdSizes.push_back(size);
+    }
+    setup.holdOperations = holdOperations;
+    setup.graph = makeRandomGraph(min(maxSize, GRAPH_MAX_VERTICES), GRAPH_DEGREE, GRAPH_MAX_WEIGHT, 1);
+
+    HeapPriorityQueue<long long> queue;
+    long numOperations;
+    if (trace.empty()) {
+        TraceRecorder<HeapPriorityQueue<long long> > recorder(queue, setup.trace);
+        runDijkstra(recorder, setup.graph, numOperations, setup.dijkstraChecksum);
+    } else {
+        runDijkstra(queue, setup.graph, numOperations, setup.dijkstraChecksum);
+        if (peakSize(trace) <= maxSize) setup.trace = trace;
+    }
+    return setup;
+}
+
+/*
+ * Function: printCsvResult
+ * ------------------------------------------------------------
+ * Write one row of workload results as CSV.
+ */
+void printCsvResult(ostream& csv, string workload, string name, int size,
+                    long numOperations, BenchmarkStats stats) {
+    double nanosecondsPerOperation = 1e9 / numOperations;
+    csv << workload << "," << name << "," << size << "," << numOperations << ","
+        << stats.median * nanosecondsPerOperation << ","
+        << stats.p99 * nanosecondsPerOperation << ","
+        << stats.repetitions << endl;
+}
+
+/*
+ * Function: runWorkloads
+ * ------------------------------------------------------------
+ * Run every workload on one type of queue and write the results as CSV.
+ *   Each repetition gets a new queue, made outside the timed part. Every
+ *   queue must find the same distances in Dijkstra's algorithm.
+ */
+template <typename PQueue>
+void runWorkloads(string name, const WorkloadSetup& setup, ostream& csv) {
+    for (size_t i = 0; i < setup.holdSizes.size(); i++) {
+        int size = setup.holdSizes[i];
+        BenchmarkStats stats = measure([&]() {
+            PQueue queue;
+            return runHoldModel(queue, size, setup.holdOperations, 2);
+        });
+        printCsvResult(csv, "hold", name, size, 2L * setup.holdOperations, stats);
+    }
+
+    long numOperations = 0;
+    long long checksum = 0;
+    BenchmarkStats stats = measure([&]() {
+        PQueue queue;
+        return runDijkstra(queue, setup.graph, numOperations, checksum);
+    });
+    if (checksum != setup.dijkstraChecksum) error(name + " found the wrong distances in Dijkstra's algorithm");
+    printCsvResult(csv, "dijkstra", name, setup.graph.numVertices(), numOperations, stats);
+
+    if (!setup.trace.empty()) {
+        stats = measure([&]() {
+            PQueue queue;
+            return replayTrace(queue, setup.trace);
+        });
+        printCsvResult(csv, "trace", name, peakSize(setup.trace), setup.trace.size(), stats);
+    }
+}
+
+/*
+ * Function: runAllWorkloads
+ * ------------------------------------------------------------
+ * Run the workloads on every queue, the linear ones on smaller sizes.
+ */
+void runAllWorkloads(int maxSize, const Trace& trace, ostream& csv) {
+    WorkloadSetup setup = makeWorkloadSetup(maxSize, HOLD_OPERATIONS, trace);
+    WorkloadSetup linearSetup = makeWorkloadSetup(min(maxSize, LINEAR_QUEUE_MAX_SIZE),
+                                                  LINEAR_HOLD_OPERATIONS, trace);
+
+    csv << "workload,queue,size,operations,median_ns,p99_ns,repetitions" << endl;
+    runWorkloads<HeapPriorityQueue<long long> >("Heap", setup, csv);
+    runWorkloads<HeapPriorityQueue<long long, less<long long>, 4> >("4-ary Heap", setup, csv);
+    runWorkloads<PairingHeapPriorityQueue<long long> >("Pairing Heap", setup, csv);
+    runWorkloads<FibonacciHeapPriorityQueue<long long> >("Fib Heap", setup, csv);
+    runWorkloads<SkipListPriorityQueue<long long> >("Skip List", setup, csv);
+    runWorkloads<RadixPriorityQueue<long long, IntegerKey<long long> > >("Radix Queue", setup, csv);
+    runWorkloads<ConcurrentHeapPriorityQueue<long long> >("Concurrent Heap", setup, csv);
+    runWorkloads<LockFreeSkipListPriorityQueue<long long> >("Lock-Free Skip List", setup, csv);
+    runWorkloads<MultiQueuePriorityQueue<long long> >("MultiQueue", setup, csv);
+    runWorkloads<SingleWorkerQueue<long long, IntegerKey<long long> > >("Work Stealing", setup, csv);
+    runWorkloads<VectorPriorityQueue<long long> >("Vector", linearSetup, csv);
+    runWorkloads<LinkedListPriorityQueue<long long> >("Linked List", linearSetup, csv);
+    runWorkloads<DoublyLinkedListPriorityQueue<long long> >("Double Linked List", linearSetup, csv);
+}
+
+int main() {
+    string answer = getLine("Only report the bytes per value of each queue? (y/n, blank for no): ");
+    if (!answer.empty() && tolower(answer[0]) == 'y') {
+        runMemoryReport();
+        return 0;
+    }
+
+    answer = getLine("Largest queue size to benchmark (blank for "
+                            + integerToString(DEFAULT_MAX_SIZE) + "): ");
+    int maxSize = answer.empty() ? DEFAULT_MAX_SIZE : stringToInteger(answer);
+    int linearMaxSize = min(maxSize, LINEAR_QUEUE_MAX_SIZE);
+
+    /* A trace file that exists is replayed; otherwise the trace recorded
+     * from Dijkstra's algorithm is saved under that name.
+     */
+    Trace trace;
+    string traceFile = getLine("Trace file to replay, or to record into if it does not exist (blank for none): ");
+    if (!traceFile.empty()) {
+        ifstream in(traceFile.c_str(), ios::binary);
+        if (in) {
+            trace = readTrace(in);
+        } else {
+            trace = makeWorkloadSetup(maxSize, 0, trace).trace;
+            ofstream out(traceFile.c_str(), ios::binary);
+            writeTrace(out, trace);
+        }
+    }
+    string csvFile = getLine("CSV file for the workload results (blank for the console): ");
+
+    /* The counters are only read if asked for, and only if the system
+     * lets at least one of them be opened.
+     */
+    PerfCounters perfCounters;
+    PerfCounters* perf = NULL;
+    answer = getLine("Read hardware counters in the phase sweep? (y/n, blank for no): ");
+    if (!answer.empty() && tolower(answer[0]) == 'y') {
+        if (perfCounters.isAnyAvailable()) {
+            perf = &perfCounters;
+        } else {
+            cout << "Hardware counters are not available: " << PerfCounters::unavailableReason() << endl;
+        }
+    }
+
+    if (csvFile.empty()) {
+        runAllWorkloads(maxSize, trace, cout);
+    } else {
+        ofstream csv(csvFile.c_str());
+        if (!csv) error("Could not open " + csvFile);
+        runAllWorkloads(maxSize, trace, csv);
+    }
+    cout << endl;
+
+    printHeader(perf);
+    benchmarkQueue<HeapPriorityQueue<int> >("Heap", maxSize, perf);
+    benchmarkQueue<HeapPriorityQueue<int, less<int>, 4> >("4-ary Heap", maxSize, perf);
+    benchmarkQueue<HeapPriorityQueue<int, less<int>, 4, true> >("4-ary Heap (cache aligned)", maxSize, perf);
+    benchmarkQueue<PairingHeapPriorityQueue<int> >("Pairing Heap", maxSize, perf);
+    benchmarkQueue<FibonacciHeapPriorityQueue<int> >("Fib Heap", maxSize, perf);
+    benchmarkQueue<SkipListPriorityQueue<int> >("Skip List", maxSize, perf);
+    benchmarkQueue<LockFreeSkipListPriorityQueue<int> >("Lock-Free Skip List", maxSize, perf);
+    benchmarkQueue<RadixPriorityQueue<int, IntegerKey<int> > >("Radix Queue", maxSize, perf);
+    benchmarkQueue<ConcurrentHeapPriorityQueue<int> >("Concurrent Heap", maxSize, perf);
+    benchmarkQueue<MultiQueuePriorityQueue<int> >("MultiQueue", maxSize, perf);
+    benchmarkQueue<SingleWorkerQueue<int, IntegerKey<int> > >("Work Stealing", maxSize, perf);
+    benchmarkQueue<VectorPriorityQueue<int> >("Vector", linearMaxSize, perf);
+    benchmarkQueue<VectorPriorityQueue<int, less<int>, IntegerKey<int> > >(
+        string("Vector (packed keys, ") + argminKernelName(activeArgminKernel()) + ")", linearMaxSize, perf);
+    benchmarkQueue<LinkedListPriorityQueue<int> >("Linked List", linearMaxSize, perf);
+    benchmarkQueue<DoublyLinkedListPriorityQueue<int> >("Double Linked List", linearMaxSize, perf);
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**********************************************
+ * File: pqueue-benchmark.h
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * Helpers for timing the priority queues, shared by the speed tests in
+ * pqueue-test.cpp and the standalone benchmark in pqueue-benchmark.cpp.
+ *
+ * Times are wall times taken from steady_clock, which unlike clock() does
+ * not add up the time of every thread and is not moved by changes to the
+ * system clock. A benchmark is run a few times untimed to warm the caches
+ * and the allocator, then repeated, and summarized by the median and the
+ * 99th percentile of its repetitions rather than the mean, so that a
+ * single repetition interrupted by the operating system does not skew the
+ * result.
+ */
+#ifndef PQueue_Benchmark_Included
+#define PQueue_Benchmark_Included
+
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include "error.h"
+using namespace std;
+
+/* Type: Stopwatch
+ * Measures the wall time since it was created or last restarted.
+ */
+class Stopwatch {
+public:
+	/* Creates a stopwatch that starts running right away. */
+	Stopwatch() : begin(chrono::steady_clock::now()) {}
+
+	/* Starts timing again from now. */
+	void restart() {
+		begin = chrono::steady_clock::now();
+	}
+
+	/* Returns the number of seconds since the stopwatch was started. */
+	double seconds() const {
+		return chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+	}
+
+private:
+	chrono::steady_clock::time_point begin;
+};
+
+/* Type: BenchmarkStats
+ * A summary of the times taken by the repetitions of a benchmark.
+ */
+struct BenchmarkStats {
+	double median;
+	double p99;
+	int repetitions;
+};
+
+/* Function: summarizeSamples
+ * Returns the median and the 99th percentile of a list of times. The
+ * percentile is by nearest rank, so with fewer than a hundred samples it
+ * is the largest one.
+ */
+inline BenchmarkStats summarizeSamples(vector<double> samples) {
+	if (samples.empty()) error("Cannot summarize an empty list of samples");
+
+	sort(samples.begin(), samples.end());
+	BenchmarkStats stats;
+	int count = samples.size();
+	stats.median = (count % 2 == 1) ? samples[count / 2]
+	                                : (samples[count / 2 - 1] + samples[count / 2]) / 2;
+	int rank = (99 * count + 99) / 100;
+	stats.p99 = samples[rank - 1];
+	stats.repetitions = count;
+	return stats;
+}
+
+/* Function: runRepetitions
+ * Calls sample, which times one repetition of a benchmark and returns the
+ * seconds it took, numWarmups times without recording the result and then
+ * numRepetitions times, and summarizes the recorded times.
+ */
+template <typename Sample>
+BenchmarkStats runRepetitions(int numWarmups, int numRepetitions, Sample sample) {
+	for (int i = 0; i < numWarmups; i++) {
+		sample();
+	}
+	vector<double> samples;
+	for (int i = 0; i < numRepetitions; i++) {
+		samples.push_back(sample());
+	}
+	return summarizeSamples(samples);
+}
+
+/* Function: doNotOptimize
+ * Makes the compiler believe that value is used, so that the work that
+ * computed it cannot be optimized away.
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r"(&value) : "memory");
+#else
+	static const T* volatile sink;
+	sink = &value;
+#endif
+}
+
+#endif
@@ -0,0 +1,526 @@
+/**********************************************
+ * File: pqueue-concurrentheap.h
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * A priority queue class backed by a binary heap that several threads can
+ *   use at once, following the fine-grained locking scheme of Hunt, Michael,
+ *   Parthasarathy and Scott ("An efficient algorithm for concurrent priority
+ *   queue heaps", 1996).
+ *
+ * Instead of one lock around the whole heap, every slot has a lock of its
+ *   own, and a short-lived lock on the heap itself only protects its size.
+ *   An operation holds the heap lock just long enough to claim the slot at
+ *   the bottom of the heap, then sifts with at most two or three slot locks
+ *   held at a time, always taking a parent's lock before its child's so
+ *   that operations cannot deadlock. Inserts sift up and deletes sift down
+ *   at the same time in different parts of the heap.
+ *
+ * Each slot carries a tag: EMPTY, AVAILABLE, or the tag of an insert that
+ *   is still sifting its value up. A delete may move that value out from
+ *   under the insert, which notices because the tag is no longer its own
+ *   and follows the value upwards. Consecutive inserts are placed at
+ *   bit-reversed positions on the bottom level, so that inserts running at
+ *   the same time sift up through different subtrees.
+ *
+ * The slots are kept in one block per level of the heap. Blocks are only
+ *   ever added, so a slot never moves while another thread is using it.
+ */
+#ifndef PQueue_ConcurrentHeap_Included
+#define PQueue_ConcurrentHeap_Included
+
+#include <string>
+#include <functional>
+#include <utility>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include "error.h"
+#include "pqueue-stats.h"
+#include "pqueue-memoryusage.h"
+using namespace std;
+
+/* A class representing a priority queue backed by a binary heap with a
+ * lock per slot. Values are ordered by Compare, which defaults to
+ * operator<, and must be default constructible.
+ *
+ * All operations may be called from several threads at once. Since the
+ * queue can change between two calls, a consumer that does not know
+ * whether the queue is empty should use tryDequeueMin() rather than
+ * isEmpty() followed by dequeueMin(), and peek() returns a copy of the
+ * value rather than a reference.
+ *
+ * Stats is a stats policy from pqueue-stats.h. CountingStats is safe to
+ * update from every thread; each swap between two slots counts as two
+ * moves, and each new level of slots as a resize.
+ */
+template <typename ValueType, typename Compare = less<ValueType>, typename Stats = NoStats>
+class ConcurrentHeapPriorityQueue : private Stats {
+public:
+	/* Constructs a new, empty priority queue ordered by the given comparator. */
+	explicit ConcurrentHeapPriorityQueue(Compare compare = Compare());
+
+	/* Cleans up all memory allocated by this priority queue. No other thread
+	 * may be using the queue any more.
+	 */
+	~ConcurrentHeapPriorityQueue();
+
+	/* Returns the number of elements in the priority queue. */
+	int size();
+
+	/* Returns whether or not the priority queue is empty. */
+	bool isEmpty();
+
+	/* Enqueues a copy of a value into the priority queue. */
+	void enqueue(const ValueType& value);
+
+	/* Enqueues a value into the priority queue, moving it into storage. */
+	void enqueue(ValueType&& value);
+
+	/* Enqueues a value constructed from the given arguments. */
+	template <typename... Args>
+	void emplace(Args&&... args);
+
+	/* Returns a copy of, but does not remove, the first value in the
+	 * priority queue.
+	 */
+	ValueType peek();
+
+	/* Returns and removes the first value in the priority queue. */
+	ValueType dequeueMin();
+
+	/* Removes the first value in the priority queue and moves it into
+	 * result. Returns false, leaving result alone, if the queue is empty.
+	 */
+	bool tryDequeueMin(ValueType& result);
+
+	/* Removes the k smallest values from the priority queue and writes them
+	 * to out in sorted order. Returns the output iterator one past the last
+	 * value written. The values are removed one at a time, so other threads
+	 * may remove values in between.
+	 */
+	template <typename OutputIterator>
+	OutputIterator dequeueMin(int k, OutputIterator out);
+
+	/* Removes every value from the priority queue. */
+	void clear();
+
+	/* Moves every value of other into this priority queue, leaving other
+	 * empty. The values are moved one at a time, so other threads may see
+	 * some of them in both queues' counts or in neither.
+	 */
+	void merge(ConcurrentHeapPriorityQueue& other);
+
+	/* Returns the stats the queue has kept so far. */
+	const Stats& stats();
+
+	/* Returns the bytes the heap takes, split into the values and the
+	 * overhead of the slots' locks and tags and of the levels not filled yet.
+	 */
+	MemoryUsage memoryUsage();
+
+private:
+	// a slot of the heap, guarded by its own lock
+	struct Slot {
+		mutex lock;
+		uint64_t tag;
+		ValueType value;
+	};
+
+	// tags of a slot that no insert is sifting up; other tags belong to
+	//   one particular insert
+	static const uint64_t EMPTY = 0;
+	static const uint64_t AVAILABLE = 1;
+
+	// the slots of level k, which are numbered 2^k to 2^(k + 1) - 1; with
+	//   30 levels the capacity, 2^30, still fits in an int
+	static const int MAX_LEVELS = 30;
+	Slot* levels[MAX_LEVELS];
+
+	// one more than the number of the last slot allocated, always a power
+	//   of two; the slots below it can be used without holding heapLock
+	atomic<int> capacity;
+
+	// lock guarding the number of values and the allocation of levels
+	mutex heapLock;
+	int numValues;
+
+	// source of the tags that inserts give their values
+	atomic<uint64_t> nextTag;
+
+	// comparator deciding which of two values comes first
+	Compare isLess;
+
+	// compare two values, counting the comparison
+	bool lessThan(const ValueType& a, const ValueType& b);
+
+	// get the slot with a given number, counting from 1 at the root
+	Slot& slotAt(int index);
+
+	// get the level of the slot with a given number, which is floor(log2(index))
+	static int levelOf(int index);
+
+	// get the number of the slot that the nth value goes in
+	static int bottomSlot(int n);
+
+	// add the value in a slot tagged with myTag, that has been placed at
+	//   index, to the heap
+	void siftUp(int index, uint64_t myTag);
+
+	// disallow copying, since the slots hold locks
+	ConcurrentHeapPriorityQueue(const ConcurrentHeapPriorityQueue&);
+	ConcurrentHeapPriorityQueue& operator=(const ConcurrentHeapPriorityQueue&);
+};
+
+/*************************************************************
+ * Implementation of the ConcurrentHeapPriorityQueue class. Since the class
+ * is a template, the implementation has to be visible in the header.
+ */
+
+/*
+ * Constructor to start the heap with no levels at all.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::ConcurrentHeapPriorityQueue(Compare compare)
+    : capacity(1), numValues(0), nextTag(AVAILABLE + 1), isLess(compare) {
+    for (int level = 0; level < MAX_LEVELS; level++) {
+        levels[level] = NULL;
+    }
+}
+
+/*
+ * Destructor to free every level.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::~ConcurrentHeapPriorityQueue() {
+    for (int level = 0; level < MAX_LEVELS; level++) {
+        delete[] levels[level];
+    }
+}
+
+/*
+ * Return the current size of the queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::size() {
+    lock_guard<mutex> guard(heapLock);
+    return numValues;
+}
+
+/*
+ * Return whether the queue is empty.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::isEmpty() {
+    return (size() == 0);
+}
+
+/*
+ * Add a copy of a value to the queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::enqueue(const ValueType& value) {
+    emplace(value);
+}
+
+/*
+ * Add a value to the queue without copying it.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::enqueue(ValueType&& value) {
+    emplace(std::move(value));
+}
+
+/*
+ * Claim the next slot at the bottom of the heap while holding the heap
+ *   lock, adding a level first if the heap is full. The value is then
+ *   stored with the insert's own tag and sifted up.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename... Args>
+void ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::emplace(Args&&... args) {
+    typename Stats::Timer timer(*this, STATS_ENQUEUE);
+    ValueType value(std::forward<Args>(args)...);
+    uint64_t myTag = nextTag++;
+
+    unique_lock<mutex> heapGuard(heapLock);
+    int index = bottomSlot(numValues + 1);
+    if (index >= capacity.load(memory_order_relaxed)) {
+        int level = levelOf(index);
+        if (level >= MAX_LEVELS) error("The queue is full");
+        levels[level] = new Slot[size_t(1) << level];
+        for (size_t i = 0; i < (size_t(1) << level); i++) {
+            levels[level][i].tag = EMPTY;
+        }
+        capacity.store(2 << level, memory_order_release);
+        Stats::countResize();
+    }
+    numValues++;
+    Slot& slot = slotAt(index);
+    slot.lock.lock();
+    heapGuard.unlock();
+
+    slot.value = std::move(value);
+    slot.tag = myTag;
+    slot.lock.unlock();
+
+    siftUp(index, myTag);
+}
+
+/*
+ * Move a value up towards the root while it is smaller than its parent.
+ *   Before each step the insert checks that its value is still where it
+ *   left it: if a delete has moved it up, the insert follows it, and if
+ *   a delete has moved it to the root and made it available, it is done.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::siftUp(int index, uint64_t myTag) {
+    while (index > 1) {
+        int parent = index / 2;
+        Slot& parentSlot = slotAt(parent);
+        Slot& childSlot = slotAt(index);
+        lock_guard<mutex> parentGuard(parentSlot.lock);
+        lock_guard<mutex> childGuard(childSlot.lock);
+
+        if (parentSlot.tag == AVAILABLE && childSlot.tag == myTag) {
+            if (lessThan(childSlot.value, parentSlot.value)) {
+                swap(childSlot.value, parentSlot.value);
+                Stats::countMoves(2);
+                swap(childSlot.tag, parentSlot.tag);
+                index = parent;
+            } else {
+                childSlot.tag = AVAILABLE;
+                index = 0;
+            }
+        } else if (parentSlot.tag == EMPTY) {
+            // the value was taken by a delete and the heap has shrunk
+            index = 0;
+        } else if (childSlot.tag != myTag) {
+            // a delete moved the value up
+            index = parent;
+        }
+        // otherwise another insert is still sifting the parent, so wait
+        //   for it by trying again
+    }
+
+    if (index == 1) {
+        Slot& root = slotAt(1);
+        lock_guard<mutex> rootGuard(root.lock);
+        if (root.tag == myTag) {
+            root.tag = AVAILABLE;
+        }
+    }
+}
+
+/*
+ * Look at the value at the root.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+ValueType ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::peek() {
+    if (capacity.load(memory_order_acquire) > 1) {
+        Slot& root = slotAt(1);
+        lock_guard<mutex> rootGuard(root.lock);
+        if (root.tag != EMPTY) return root.value;
+    }
+    error("The queue is empty");
+    return ValueType();
+}
+
+/*
+ * Remove and return the smallest value in the queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+ValueType ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::dequeueMin() {
+    ValueType result;
+    if (!tryDequeueMin(result)) error("The queue is empty");
+    return result;
+}
+
+/*
+ * Remove the smallest value in the queue. The value in the last slot is
+ *   taken out while holding the heap lock. If it is no smaller than the
+ *   value at the root, it replaces the root value, which is the result, and
+ *   is sifted down, holding the lock of a slot while locking its children.
+ *   If it is smaller, which happens when it was taken from an insert that
+ *   had not sifted it up yet, it is the result itself.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::tryDequeueMin(ValueType& result) {
+    typename Stats::Timer timer(*this, STATS_DEQUEUE);
+    unique_lock<mutex> heapGuard(heapLock);
+    if (numValues == 0) return false;
+    int bottom = bottomSlot(numValues);
+    numValues--;
+    Slot& bottomSlotRef = slotAt(bottom);
+    bottomSlotRef.lock.lock();
+    heapGuard.unlock();
+
+    ValueType taken = std::move(bottomSlotRef.value);
+    bottomSlotRef.tag = EMPTY;
+    bottomSlotRef.lock.unlock();
+
+    Slot& root = slotAt(1);
+    root.lock.lock();
+    if (root.tag == EMPTY || lessThan(taken, root.value)) {
+        root.lock.unlock();
+        result = std::move(taken);
+        return true;
+    }
+    result = std::move(root.value);
+    root.value = std::move(taken);
+    Stats::countMoves(1);
+    root.tag = AVAILABLE;
+
+    // capacity is read again at every step while holding the lock of the
+    //   current slot: an insert that adds a level after that read has to
+    //   lock the current slot to sift up, so it will compare against the
+    //   value moved there
+    int index = 1;
+    while (2 * index + 1 < capacity.load(memory_order_acquire)) {
+        Slot& current = slotAt(index);
+        Slot& left = slotAt(2 * index);
+        Slot& right = slotAt(2 * index + 1);
+        left.lock.lock();
+        right.lock.lock();
+
+        Slot* child;
+        if (left.tag == EMPTY) {
+            right.lock.unlock();
+            left.lock.unlock();
+            break;
+        } else if (right.tag == EMPTY || !lessThan(right.value, left.value)) {
+            right.lock.unlock();
+            child = &left;
+        } else {
+            left.lock.unlock();
+            child = &right;
+        }
+
+        if (lessThan(child->value, current.value)) {
+            swap(child->value, current.value);
+            Stats::countMoves(2);
+            swap(child->tag, current.tag);
+            current.lock.unlock();
+            index = (child == &left) ? 2 * index : 2 * index + 1;
+        } else {
+            child->lock.unlock();
+            break;
+        }
+    }
+    slotAt(index).lock.unlock();
+    return true;
+}
+
+/*
+ * Remove the k smallest elements from the queue one at a time.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename OutputIterator>
+OutputIterator ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::dequeueMin(int k, OutputIterator out) {
+    if (k < 0 || k > size()) error("Cannot dequeue more values than the queue holds");
+
+    for (int i = 0; i < k; i++) {
+        *out++ = dequeueMin();
+    }
+    return out;
+}
+
+/*
+ * Remove every element from the queue. The levels stay allocated for the
+ *   values that are added next.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::clear() {
+    ValueType discarded;
+    while (tryDequeueMin(discarded)) {
+    }
+}
+
+/*
+ * Merge another queue into this one by moving its values over one at a
+ *   time.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::merge(ConcurrentHeapPriorityQueue& other) {
+    if (&other == this) return;
+    ValueType value;
+    while (other.tryDequeueMin(value)) {
+        emplace(std::move(value));
+    }
+}
+
+/*
+ * Get a slot by its number, from the block of its level.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+typename ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::Slot&
+ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::slotAt(int index) {
+    int level = levelOf(index);
+    return levels[level][index - (1 << level)];
+}
+
+/*
+ * Get the level of a slot from the position of its highest bit.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::levelOf(int index) {
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(unsigned(index));
+#else
+    int level = 0;
+    while ((int64_t(2) << level) <= index) level++;
+    return level;
+#endif
+}
+
+/*
+ * Get the slot for the nth value. The nth value goes on level
+ *   floor(log2(n)), at the position given by reversing the bits of its
+ *   offset within the level, so that consecutive values are spread across
+ *   the level instead of filling it from left to right.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::bottomSlot(int n) {
+    int level = levelOf(n);
+    int offset = n - (1 << level);
+    int reversed = 0;
+    for (int bit = 0; bit < level; bit++) {
+        reversed = (reversed << 1) | ((offset >> bit) & 1);
+    }
+    return (1 << level) + reversed;
+}
+
+/*
+ * Return the stats kept so far.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+const Stats& ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::stats() {
+    return *this;
+}
+
+/*
+ * Count every level allocated so far, holding the heap lock so that no
+ *   level is added meanwhile.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+MemoryUsage ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::memoryUsage() {
+    lock_guard<mutex> guard(heapLock);
+    size_t totalBytes = sizeof(*this);
+    for (int level = 0; level < MAX_LEVELS && levels[level] != NULL; level++) {
+        totalBytes += (size_t(1) << level) * sizeof(Slot);
+    }
+    return MemoryUsage(numValues * sizeof(ValueType), totalBytes);
+}
+
+/*
+ * Compare two values with the comparator, counting the comparison in the
+ *   stats.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool ConcurrentHeapPriorityQueue<ValueType, Compare, Stats>::lessThan(const ValueType& a, const ValueType& b) {
+    Stats::countComparison();
+    return isLess(a, b);
+}
+
+#endif
@@ -9,62 +9,412 @@
 #define PQueue_DoublyLinkedList_Included
 
 #include <string>
+#include <functional>
+#include <vector>
+#include <algorithm>
+#include <utility>
 #include <iostream>
 #include "simpio.h"
+#include "pqueue-nodepool.h"
+#include "error.h"
+#include "pqueue-stats.h"
+#include "pqueue-memoryusage.h"
 
 using namespace std;
 
 /* Type: Cell
  * A cell in a linked list.
  */
+template <typename ValueType>
 struct DlCell {
-	string value;
+	ValueType value;
 	DlCell* next = NULL;
 	DlCell* previous = NULL;
+
+	/* Constructs the value in place from the given arguments. */
+	template <typename... Args>
+	explicit DlCell(Args&&... args) : value(std::forward<Args>(args)...) {}
 };
 
 /* A class representing a priority queue backed by an unsorted,
- * doubly-linked list.
+ * doubly-linked list. Values are ordered by Compare, which defaults
+ * to operator<. With the CountingStats policy the queue counts the
+ * comparisons of its scans for the smallest value.
  */
-class DoublyLinkedListPriorityQueue {
+template <typename ValueType, typename Compare = less<ValueType>, typename Stats = NoStats>
+class DoublyLinkedListPriorityQueue : private Stats {
 public:
 	/* Constructs a new, empty priority queue backed by a doubly-linked list. */
-	DoublyLinkedListPriorityQueue();
-	
+	explicit DoublyLinkedListPriorityQueue(Compare compare = Compare());
+
+	/* The pool that the cells of this kind of queue are allocated from. */
+	typedef NodePool<DlCell<ValueType> > Pool;
+
+	/* Constructs a new, empty priority queue that allocates its cells from
+	 * a pool shared with other queues. The pool must outlive the queue.
+	 */
+	explicit DoublyLinkedListPriorityQueue(Pool& sharedPool, Compare compare = Compare());
+
 	/* Cleans up all memory allocated by this priority queue. */
 	~DoublyLinkedListPriorityQueue();
-	
+
 	/* Returns the number of elements in the priority queue. */
 	int size();
-	
+
 	/* Returns whether or not the priority queue is empty. */
 	bool isEmpty();
-	
-	/* Enqueues a new string into the priority queue. */
-	void enqueue(string value);
-	
-	/* Returns, but does not remove, the lexicographically first string in the
-	 * priority queue.
+
+	/* Enqueues a copy of a value into the priority queue. */
+	void enqueue(const ValueType& value);
+
+	/* Enqueues a value into the priority queue, moving it into storage. */
+	void enqueue(ValueType&& value);
+
+	/* Enqueues a value constructed in place from the given arguments. */
+	template <typename... Args>
+	void emplace(Args&&... args);
+
+	/* Returns, but does not remove, the first value in the priority queue. */
+	const ValueType& peek();
+
+	/* Returns and removes the first value in the priority queue. */
+	ValueType dequeueMin();
+
+	/* Removes the k smallest values from the priority queue and writes them
+	 * to out in sorted order. Returns the output iterator one past the last
+	 * value written.
 	 */
-	string peek();
-	
-	/* Returns and removes the lexicographically first string in the
-	 * priority queue.
+	template <typename OutputIterator>
+	OutputIterator dequeueMin(int k, OutputIterator out);
+
+	/* Removes every value from the priority queue. */
+	void clear();
+
+	/* Moves every value of other into this priority queue, leaving other
+	 * empty. The lists are joined in time linear in the size of other and
+	 * no value is copied.
+	 */
+	void merge(DoublyLinkedListPriorityQueue& other);
+
+	/* Returns the stats the queue has kept so far. */
+	const Stats& stats();
+
+	/* Returns the bytes the queue takes, split into the values and the
+	 * overhead of the cells holding them, each with two links. A queue that
+	 * owns its pool counts all of it; a queue that shares its pool counts
+	 * only its own cells.
 	 */
-	string dequeueMin();
+	MemoryUsage memoryUsage();
 
 private:
     // doubly linked list
-    DlCell* list;
-    
+    DlCell<ValueType>* list;
+
     // the number of cells in the linked list
     int numCells;
-    
+
+    // comparator deciding which of two values comes first
+    Compare isLess;
+
+    // compare two values, counting the comparison
+    bool lessThan(const ValueType& a, const ValueType& b);
+
+    // pool used when the queue is not given one to share, and the pool
+    //   that the cells actually come from
+    Pool ownPool;
+    Pool* pool;
+
     // find the smallest cell in the list
-    DlCell* findMinCell();
-    
+    DlCell<ValueType>* findMinCell();
+
+    // unlink a cell from the list and deallocate it
+    void removeCell(DlCell<ValueType>* toRemove);
+
     // print the linked list; useful for debugging
     void printLinkedList();
 };
 
+/*************************************************************
+ * Implementation of the DoublyLinkedListPriorityQueue class. Since the
+ * class is a template, the implementation has to be visible in the header.
+ */
+
+/*
+ * Constructor to initialize the linked list.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::DoublyLinkedListPriorityQueue(Compare compare)
+    : isLess(compare) {
+    numCells = 0;
+    list = NULL;
+    pool = &ownPool;
+}
+
+/*
+ * Constructor to initialize the linked list, taking its cells from a
+ *   shared pool.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::DoublyLinkedListPriorityQueue(Pool& sharedPool,
+                                                                                        Compare compare)
+    : isLess(compare) {
+    numCells = 0;
+    list = NULL;
+    pool = &sharedPool;
+}
+
+/*
+ * Destructor to deallocate all memory from the linked list.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::~DoublyLinkedListPriorityQueue() {
+    clear();
+}
+
+/*
+ * Return the size of the linked list.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::size() {
+    return numCells;
+}
+
+/*
+ * Return whether the list is empty.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::isEmpty() {
+    return (numCells == 0);
+}
+
+/*
+ * Add a copy of a value to the queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::enqueue(const ValueType& value) {
+    emplace(value);
+}
+
+/*
+ * Add a value to the queue, moving it into its cell rather than copying it.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::enqueue(ValueType&& value) {
+    emplace(std::move(value));
+}
+
+/*
+ * Add a value to the list, constructing it directly inside its new cell.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename... Args>
+void DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::emplace(Args&&... args) {
+    typename Stats::Timer timer(*this, STATS_ENQUEUE);
+    DlCell<ValueType>* newCell = pool->create(std::forward<Args>(args)...);
+
+    if (list == NULL) {
+        // List is empty.
+        list = newCell;
+    } else {
+        // Append new node to the end of the list.
+        list->previous = newCell;
+        newCell->next = list;
+        list = newCell;
+    }
+
+    // new cell added, so increment the total cell count
+    numCells++;
+}
+
+/*
+ * Return the smallest element in the list.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+const ValueType& DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::peek() {
+    if (isEmpty()) error("Cannot peek at an empty list");
+    DlCell<ValueType>* min = findMinCell();
+    return min->value;
+}
+
+/*
+ * Return the smallest element in the queue and remove it from the queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+ValueType DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::dequeueMin() {
+    typename Stats::Timer timer(*this, STATS_DEQUEUE);
+    if (isEmpty()) error("Empty queue");
+    DlCell<ValueType>* toRemove = findMinCell();
+    ValueType val = std::move(toRemove->value);
+    removeCell(toRemove);
+	return val;
+}
+
+/*
+ * Remove the k smallest elements in the queue. The list is walked once to
+ *   collect its cells, and the k smallest are then picked out and sorted
+ *   together instead of scanning the whole list for each of them.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename OutputIterator>
+OutputIterator DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::dequeueMin(int k, OutputIterator out) {
+    if (k < 0 || k > numCells) error("Cannot dequeue more values than the queue holds");
+    vector<DlCell<ValueType>*> cells;
+    cells.reserve(numCells);
+    for (DlCell<ValueType>* current = list; current != NULL; current = current->next) {
+        cells.push_back(current);
+    }
+
+    partial_sort(cells.begin(), cells.begin() + k, cells.end(),
+                 [this](DlCell<ValueType>* a, DlCell<ValueType>* b) {
+                     return lessThan(a->value, b->value);
+                 });
+    for (int i = 0; i < k; i++) {
+        *out++ = std::move(cells[i]->value);
+        removeCell(cells[i]);
+    }
+    return out;
+}
+
+/*
+ * Remove every element from the queue, walking the list once and giving
+ *   each cell back to the pool.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::clear() {
+    DlCell<ValueType>* current = list;
+    while (current != NULL) {
+        DlCell<ValueType>* next = current->next;
+        pool->destroy(current);
+        current = next;
+    }
+    list = NULL;
+    numCells = 0;
+}
+
+/*
+ * Join the list of another queue onto the front of this one. Since the
+ *   list is unsorted, only the end of the other list has to be found.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::merge(DoublyLinkedListPriorityQueue& other) {
+    if (&other == this || other.isEmpty()) return;
+
+    if (!takeOverCells(pool, other.pool, other.pool == &other.ownPool)) {
+        // the other cells belong to a pool this queue cannot take over, so
+        //   move each value into a cell of this queue's pool
+        for (DlCell<ValueType>* current = other.list; current != NULL; ) {
+            DlCell<ValueType>* next = current->next;
+            emplace(std::move(current->value));
+            other.pool->destroy(current);
+            current = next;
+        }
+    } else {
+        DlCell<ValueType>* otherLast = other.list;
+        while (otherLast->next != NULL) {
+            otherLast = otherLast->next;
+        }
+        otherLast->next = list;
+        if (list != NULL) {
+            list->previous = otherLast;
+        }
+        list = other.list;
+        numCells += other.numCells;
+    }
+    other.list = NULL;
+    other.numCells = 0;
+}
+
+/*
+ * Unlink a cell from the list and deallocate its memory.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::removeCell(DlCell<ValueType>* toRemove) {
+    if (numCells == 1) {
+        // List only contains one element, so it will be empty after removal
+        list = NULL;
+    } else if (toRemove->next == NULL) {
+        // last element in list removed, so the new final cell is empty
+        toRemove->previous->next = NULL;
+    } else if (toRemove->previous == NULL) {
+        // first element in list removed, so the new first cell should have
+        //   no previous and the list now starts at a new location
+        toRemove->next->previous = NULL;
+        list = toRemove->next;
+    } else {
+        // removing an element that is not on an end
+        toRemove->next->previous = toRemove->previous;
+        toRemove->previous->next = toRemove->next;
+    }
+
+    // give the removed cell back to the pool
+    pool->destroy(toRemove);
+
+    // reduce the total count of cells in the list
+    numCells--;
+}
+
+/*
+ * Find the smallest cell in the list.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+DlCell<ValueType>* DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::findMinCell() {
+    DlCell<ValueType>* smallestCell = list;
+    int i = 0;
+
+    // iterate over the list looking for the smallest cell
+    // this step is required as the assignment calls for storing the data
+    //   in an unsorted doubly linked list.
+    for (DlCell<ValueType>* nextCell = list;
+         i < numCells;
+         nextCell = nextCell->next, i++) {
+        if (lessThan(nextCell->value, smallestCell->value)) {
+            smallestCell = nextCell;
+        }
+    }
+    return smallestCell;
+}
+
+/*
+ * Print the linked list, helpful for debugging.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::printLinkedList() {
+    cout << "going to print linked list of size " << endl;
+    for (DlCell<ValueType>* current = list;
+         current != NULL;
+         current = current->next) {
+        if (current != NULL) {
+            cout << "printing: " << current->value << endl;
+        }
+    }
+    cout << "finished printing linked list of size " << endl;
+}
+
+/*
+ * Return the stats kept so far.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+const Stats& DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::stats() {
+    return *this;
+}
+
+/*
+ * Count the cells, or the whole pool if the queue owns it.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+MemoryUsage DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::memoryUsage() {
+    size_t totalBytes = sizeof(*this) + pool->bytesFor(numCells, pool == &ownPool);
+    return MemoryUsage(numCells * sizeof(ValueType), totalBytes);
+}
+
+/*
+ * Compare two values with the comparator, counting the comparison in the
+ *   stats.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool DoublyLinkedListPriorityQueue<ValueType, Compare, Stats>::lessThan(const ValueType& a, const ValueType& b) {
+    Stats::countComparison();
+    return isLess(a, b);
+}
+
 #endif
@@ -45,8 +45,15 @@
 
 #include <string>
 #include <list>
+#include <functional>
+#include <utility>
+#include <cmath>
 #include <iostream>
 #include "simpio.h"
+#include "pqueue-nodepool.h"
+#include "error.h"
+#include "pqueue-stats.h"
+#include "pqueue-memoryusage.h"
 using namespace std;
 
 /*
@@ -61,13 +68,15 @@ using namespace std;
  *   are some different ways of implementing this.
  *
  * In the end, while I have a program below that passes all the unit tests,
- *   I am not convinced that it is a 100% true Fibonacci Heap. For example,
- *   the way I treat marking cells is not the way that the Wikipedia article
- *   and other sites indicated it should be treated. I simply could not get
- *   things to work without this and without relying on sample code that worked
- *   the way I implement things below. The implication of this one example of
- *   being too agressive in marking nodes is that the code
- *   is only slightly less efficient, as you can see from http://programmers.stackexchange.com/questions/187410/marked-nodes-in-fibonacci-heaps
+ *   I was not convinced at first that it was a 100% true Fibonacci Heap.
+ *   In particular, the first version reused the mark bit of each cell as
+ *   an "is in a list" flag, which is not the way that the Wikipedia article
+ *   and other sites indicated it should be treated. Marks now follow the
+ *   textbook definition: a cell is marked once it has lost a child since
+ *   it last became a child itself. This is what makes decreaseKey() run in
+ *   O(1) amortized time, since the cascading cuts it triggers are paid for
+ *   by the marks they clear. See also
+ *   http://programmers.stackexchange.com/questions/187410/marked-nodes-in-fibonacci-heaps
  * 
  * To look into this further, I wrote an extension that performs a detailed
  *   speed test comparison. The results for that comparison found that the
@@ -122,7 +131,11 @@ http://classes.soe.ucsc.edu/cmps201/Fall07/slides/Fibsli.pdf
 /*
  * A cell (aka node or element) of a Fibonacci Heap.
  */
+template <typename ValueType>
 struct FCell {
+    // pointer to parent cell; NULL for cells in the root list
+    FCell* parent = NULL;
+    
     // pointer to child cell
     FCell* child = NULL;
     
@@ -133,7 +146,7 @@ struct FCell {
     FCell* right = NULL;
     
     // value stored in this element cell
-    string value;
+    ValueType value;
     
     // the degree of the cell (which is the number of children)
     int degree;
@@ -145,15 +158,30 @@ struct FCell {
     // A unique number to mark the cell to enable clear printing
     //   of the heap. This is an important component for debugging.
     int cellIdNum;
+    
+    // construct the value in place from the given arguments
+    template <typename... Args>
+    explicit FCell(Args&&... args) : value(std::forward<Args>(args)...) {}
 };
 
 /*
- * Fibonacci Heap implementation of the priority queue.
+ * Fibonacci Heap implementation of the priority queue. Values are ordered
+ *   by Compare, which defaults to operator<. With the CountingStats policy
+ *   the heap also counts its consolidate passes and the trees it links.
  */
-class FibonacciHeapPriorityQueue {
+template <typename ValueType, typename Compare = less<ValueType>, typename Stats = NoStats>
+class FibonacciHeapPriorityQueue : private Stats {
   public:
-	/* Constructs a new, empty priority queue. */
-	FibonacciHeapPriorityQueue();
+	/* Constructs a new, empty priority queue ordered by the given comparator. */
+	explicit FibonacciHeapPriorityQueue(Compare compare = Compare());
+
+	/* The pool that the cells of this kind of queue are allocated from. */
+	typedef NodePool<FCell<ValueType> > Pool;
+
+	/* Constructs a new, empty priority queue that allocates its cells from
+	 * a pool shared with other queues. The pool must outlive the queue.
+	 */
+	explicit FibonacciHeapPriorityQueue(Pool& sharedPool, Compare compare = Compare());
 	
 	/* Cleans up all memory allocated by this priority queue. */
 	~FibonacciHeapPriorityQueue();
@@ -164,18 +192,64 @@ class FibonacciHeapPriorityQueue {
 	/* Returns whether or not the priority queue is empty. */
 	bool isEmpty();
 	
-	/* Enqueues a new string into the priority queue. */
-	void enqueue(string value);
+	/* A handle to a value stored in the queue. A handle stays valid until
+	 * its value leaves the queue through dequeueMin(), remove() or clear().
+	 */
+	typedef FCell<ValueType>* Handle;
+	
+	/* Enqueues a copy of a value into the priority queue and returns a
+	 * handle that can later be passed to decreaseKey() or remove().
+	 */
+	Handle enqueue(const ValueType& value);
+	
+	/* Enqueues a value into the priority queue, moving it into storage. */
+	Handle enqueue(ValueType&& value);
 	
-	/* Returns, but does not remove, the lexicographically first string in the
-	 * priority queue.
+	/* Enqueues a value constructed in place from the given arguments. */
+	template <typename... Args>
+	Handle emplace(Args&&... args);
+	
+	/* Lowers the value referred to by the handle to newValue, which must
+	 * not be larger than its current value. Runs in O(1) amortized time.
 	 */
-	string peek();
+	void decreaseKey(Handle handle, ValueType newValue);
+	
+	/* Removes the value referred to by the handle from the queue. */
+	void remove(Handle handle);
+	
+	/* Returns, but does not remove, the first value in the priority queue. */
+	const ValueType& peek();
 	
-	/* Returns and removes the lexicographically first string in the
-	 * priority queue.
+	/* Returns and removes the first value in the priority queue. */
+	ValueType dequeueMin();
+
+	/* Removes the k smallest values from the priority queue and writes them
+	 * to out in sorted order. Returns the output iterator one past the last
+	 * value written.
+	 */
+	template <typename OutputIterator>
+	OutputIterator dequeueMin(int k, OutputIterator out);
+
+	/* Removes every value from the priority queue. */
+	void clear();
+
+	/* Moves every value of other into this priority queue, leaving other
+	 * empty. The root lists are spliced together in O(1) time and no value
+	 * is copied. Handles into other then refer to this queue, unless other
+	 * shares a pool with further queues, in which case its values are moved
+	 * into new cells in linear time and its handles become invalid.
+	 */
+	void merge(FibonacciHeapPriorityQueue& other);
+
+	/* Returns the stats the queue has kept so far. */
+	const Stats& stats();
+
+	/* Returns the bytes the heap takes, split into the values and the
+	 * overhead of their cells and of the degree table. A heap that owns its
+	 * pool counts all of it; one that shares its pool counts only its own
+	 * cells.
 	 */
-	string dequeueMin();
+	MemoryUsage memoryUsage();
 
   private:
     // number of cells stored in the entire data structure
@@ -184,27 +258,711 @@ class FibonacciHeapPriorityQueue {
     // the most recently used unique cell identifier number
     int cellIdNum;
     
+    // comparator deciding which of two values comes first
+    Compare isLess;
+
+    // compare two values, counting the comparison
+    bool lessThan(const ValueType& a, const ValueType& b);
+
+    // pool used when the queue is not given one to share, and the pool
+    //   that the cells actually come from
+    Pool ownPool;
+    Pool* pool;
+    
     // consolidate the trees
     void consolidate();
     
+    // table of root cells indexed by degree, reused by every consolidate()
+    FCell<ValueType>** degreeTable;
+    
+    // number of slots allocated in the degree table
+    int degreeTableSize;
+    
+    // grow the degree table to hold the largest possible root degree
+    void ensureDegreeTableCapacity();
+    
     // add a cell to list, anchoring it at a specific cell
-    void addCellToList(FCell* toAdd, FCell*& anchorCell);
+    void addCellToList(FCell<ValueType>* toAdd, FCell<ValueType>*& anchorCell);
     
     // remove a cell from the list, with reference to its anchor cell
-    void removeCellFromList(FCell* toRemove, FCell*& anchorCell);
+    void removeCellFromList(FCell<ValueType>* toRemove, FCell<ValueType>*& anchorCell);
+    
+    // cut a cell from its parent and move it to the root list
+    void cut(FCell<ValueType>* toCut, FCell<ValueType>* parent);
+    
+    // walk up from a cell that just lost a child, cutting marked ancestors
+    void cascadingCut(FCell<ValueType>* cell);
     
     // pointer to the minimum cell in the data structure
-    FCell* minCell;
+    FCell<ValueType>* minCell;
     
     // pointer to the end of the list; used to simplify the insertion
     //   into the circular doubly linked list
-    FCell* firstCell;
+    FCell<ValueType>* firstCell;
     
     // function crucial for debugging. prints out the heap visually
     //   so it can be seen. writing an fib heap without this is
     //   almost impossible
-    void printHeap(FCell* anchorCell);
+    void printHeap(FCell<ValueType>* anchorCell);
     void printHeap();
 };
 
+/*************************************************************
+ * Implementation of the FibonacciHeapPriorityQueue class. Since the class
+ * is a template, the implementation has to be visible in the header.
+ */
+
+/*
+ * Constructor to create a new priority queue based upon the Fibonacci
+ *   Heap implementation.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::FibonacciHeapPriorityQueue(Compare compare)
+    : isLess(compare) {
+    // the heap is empty of cells when first created, so add
+    minCell = NULL;
+    firstCell = NULL;
+    numCells = 0;
+    cellIdNum = 0;
+    degreeTable = NULL;
+    degreeTableSize = 0;
+    pool = &ownPool;
+}
+
+/*
+ * Constructor to create a new, empty Fibonacci Heap whose cells come from
+ *   a pool shared with other heaps.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::FibonacciHeapPriorityQueue(Pool& sharedPool,
+                                                                                  Compare compare)
+    : isLess(compare) {
+    minCell = NULL;
+    firstCell = NULL;
+    numCells = 0;
+    cellIdNum = 0;
+    degreeTable = NULL;
+    degreeTableSize = 0;
+    pool = &sharedPool;
+}
+
+/*
+ * Destructor to eliminate the priority queue and its allocated memory.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::~FibonacciHeapPriorityQueue() {
+    clear();
+    delete[] degreeTable;
+}
+
+/*
+ * Return the total size of the priority queue. This includes all cells, not
+ *   just the number of cells in the root.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::size() {
+    return numCells;
+}
+
+/*
+ * Return whether the priority queue is empty of cells.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::isEmpty() {
+    return (numCells == 0);
+}
+
+/*
+ * Add a copy of a value to the priority queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+typename FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::Handle
+FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::enqueue(const ValueType& value) {
+    return emplace(value);
+}
+
+/*
+ * Add a value to the priority queue, moving it into its cell.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+typename FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::Handle
+FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::enqueue(ValueType&& value) {
+    return emplace(std::move(value));
+}
+
+/*
+ * Add a new value to the priority queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename... Args>
+typename FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::Handle
+FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::emplace(Args&&... args) {
+    typename Stats::Timer timer(*this, STATS_ENQUEUE);
+
+    // create a new cell to store the value and information about related
+    //   cells; the value the client wants stored in the queue is
+    //   constructed directly inside the cell
+    FCell<ValueType>* newCell = pool->create(std::forward<Args>(args)...);
+    
+    // a new cell, upon just being created, will have no children so
+    //   its degree is 0.
+    newCell->degree = 0;
+    
+    // set the unique identifier number for the newly added cell.
+    //   This enables printing out the heap easily. Due to the complexity
+    //   of this entire program, this debugging code is kept in the final
+    //   compilation so it could be debugged later if an add-on were added.
+    newCell->cellIdNum = ++cellIdNum;
+
+    // add the new cell to the root linked list
+    //   this is described in slides 7-9 of the Princeton Lectures
+    //   this is what the Wikipedia article calls the Insert step
+    addCellToList(newCell, firstCell);
+    
+    // having added a new cell to the heap, increment the counter of the
+    //   total number of cells in the heap
+    numCells++;
+    
+    // determine whether the newly added value, contained within the newCell,
+    //   should marked as the minimum value.
+    // this occurs in one of two cases:
+    //   (1) the heap had no cell, so the newCell will be the smallest
+    //   (2) the newCell value is smaller than the current min cell value, which
+    //           means the new cell will now be the new smallest cell
+    if(numCells == 1 || lessThan(newCell->value, minCell->value))
+        minCell = newCell;
+    
+    // the cell itself serves as the handle to the value
+    return newCell;
+}
+
+/*
+ * Return, but do not remove, the smallest element currently in the heap.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+const ValueType& FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::peek() {
+    if (isEmpty()) error("Cannot peek at an empty list");
+    return minCell->value;
+}
+
+/*
+ * Return and remove the smallest element currently in the heap.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+ValueType FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::dequeueMin() {
+    typename Stats::Timer timer(*this, STATS_DEQUEUE);
+    if (isEmpty()) error("Cannot dequeue at an empty list");
+    
+    // before remiving the minimum cell, move the value out of the
+    //   minimum cell so that it can be returned after the
+    //   cell is deallocated
+    ValueType val = std::move(minCell->value);
+    
+    // remove the smallest cell from its list, which is connected to the list
+    //   that forms the linked list of root cells
+    removeCellFromList(minCell, firstCell);
+    
+    // take all the children of the minimum cell, which lies in the root list
+    //   and as long as there is still a child to the min cell, remove the
+    //   child and promote it to the root list
+    // Wikipedia calls this the extract Minimum Operation while the
+    //   Princeton lectures call this the Delete Min operation
+
+    FCell<ValueType>* temp; // create a temp variable to store the child once it is
+                 //   cut from its parent
+    while (minCell->child != NULL) {
+        // temporarily store the child element
+        temp = minCell->child;
+
+        // remove the child of the minimum cell
+        removeCellFromList(temp, minCell->child);
+        
+        // add the child of the minimum cell to the root list by
+        //   adding it as a sibling of the first cell in the root list;
+        //   roots have no parent and are never marked
+        addCellToList(temp, firstCell);
+        temp->parent = NULL;
+        temp->isMarked = false;
+    };
+    
+    // give the cell created in enqueue() back to the pool
+    pool->destroy(minCell);
+    
+    // since a cell is being removed from the heap, reduce the total count
+    //   of cells
+    numCells--;
+    
+    // if the heap is not empty, consolidate the list tree
+    if (numCells > 0) {
+        consolidate();
+    }
+
+    // return the minimum value
+    return val;
+}
+
+/*
+ * Remove the k smallest elements in the heap. Each is extracted in turn;
+ *   the consolidate() after each extraction leaves few roots behind, so
+ *   the extractions that follow it are cheap.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename OutputIterator>
+OutputIterator FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::dequeueMin(int k, OutputIterator out) {
+    if (k < 0 || k > numCells) error("Cannot dequeue more values than the heap holds");
+    for (int i = 0; i < k; i++) {
+        *out++ = dequeueMin();
+    }
+    return out;
+}
+
+/*
+ * Remove every cell from the heap. Rather than extracting the minimum over
+ *   and over, which would consolidate the heap after every cell, the trees
+ *   are taken apart directly: the root list is opened into a chain, and
+ *   whenever a cell with children is reached its child list is spliced
+ *   into the chain right after it. Every cell is visited once.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::clear() {
+    if (firstCell != NULL) {
+        firstCell->left->right = NULL;
+        FCell<ValueType>* cell = firstCell;
+        while (cell != NULL) {
+            if (cell->child != NULL) {
+                FCell<ValueType>* lastChild = cell->child->left;
+                lastChild->right = cell->right;
+                cell->right = cell->child;
+            }
+            FCell<ValueType>* next = cell->right;
+            pool->destroy(cell);
+            cell = next;
+        }
+    }
+    minCell = NULL;
+    firstCell = NULL;
+    numCells = 0;
+}
+
+/*
+ * Merge another heap into this one by splicing its circular root list into
+ *   this heap's root list, which is exactly what a Fibonacci heap's lazy
+ *   root list is designed for. The trees are only consolidated by a later
+ *   dequeueMin().
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::merge(FibonacciHeapPriorityQueue& other) {
+    if (&other == this || other.isEmpty()) return;
+
+    if (!takeOverCells(pool, other.pool, other.pool == &other.ownPool)) {
+        // the other cells belong to a pool this heap cannot take over, so
+        //   take the other heap apart as clear() does, moving each value
+        //   into a cell of this heap's pool
+        other.firstCell->left->right = NULL;
+        FCell<ValueType>* cell = other.firstCell;
+        while (cell != NULL) {
+            if (cell->child != NULL) {
+                FCell<ValueType>* lastChild = cell->child->left;
+                lastChild->right = cell->right;
+                cell->right = cell->child;
+            }
+            FCell<ValueType>* next = cell->right;
+            emplace(std::move(cell->value));
+            other.pool->destroy(cell);
+            cell = next;
+        }
+    } else {
+        if (firstCell == NULL) {
+            firstCell = other.firstCell;
+            minCell = other.minCell;
+        } else {
+            // cut both circles open next to their anchors and join the ends
+            FCell<ValueType>* afterFirst = firstCell->right;
+            FCell<ValueType>* otherLast = other.firstCell->left;
+            firstCell->right = other.firstCell;
+            other.firstCell->left = firstCell;
+            otherLast->right = afterFirst;
+            afterFirst->left = otherLast;
+            if (lessThan(other.minCell->value, minCell->value)) {
+                minCell = other.minCell;
+            }
+        }
+        numCells += other.numCells;
+    }
+    other.minCell = NULL;
+    other.firstCell = NULL;
+    other.numCells = 0;
+}
+
+/*
+ * Lower the value stored in a cell. If the cell now violates the heap
+ *   order with its parent, cut it loose into the root list and let
+ *   cascadingCut() restructure its ancestors.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::decreaseKey(Handle handle, ValueType newValue) {
+    if (lessThan(handle->value, newValue)) error("New value is larger than the current value");
+    handle->value = std::move(newValue);
+    
+    FCell<ValueType>* parent = handle->parent;
+    if (parent != NULL && lessThan(handle->value, parent->value)) {
+        cut(handle, parent);
+        cascadingCut(parent);
+    }
+    
+    // the decreased cell is in the root list if it could be the new minimum
+    if (lessThan(handle->value, minCell->value)) {
+        minCell = handle;
+    }
+}
+
+/*
+ * Remove an arbitrary cell from the heap. This is a decrease-key to
+ *   negative infinity followed by dequeueMin(): the cell is cut into the
+ *   root list, made the minimum and then extracted like any other minimum.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::remove(Handle handle) {
+    FCell<ValueType>* parent = handle->parent;
+    if (parent != NULL) {
+        cut(handle, parent);
+        cascadingCut(parent);
+    }
+    minCell = handle;
+    dequeueMin();
+}
+
+/*
+ * Cut a cell away from its parent's child list and make it a root.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::cut(FCell<ValueType>* toCut,
+                                                                FCell<ValueType>* parent) {
+    removeCellFromList(toCut, parent->child);
+    (parent->degree)--;
+    
+    addCellToList(toCut, firstCell);
+    toCut->parent = NULL;
+    toCut->isMarked = false;
+}
+
+/*
+ * Having cut a child from a cell, walk up the tree. An unmarked cell is
+ *   marked to remember that it lost a child; a cell that was already marked
+ *   has now lost two children, so it is cut as well and the walk continues
+ *   with its parent. Roots are never marked.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::cascadingCut(FCell<ValueType>* cell) {
+    FCell<ValueType>* parent = cell->parent;
+    while (parent != NULL) {
+        if (!cell->isMarked) {
+            cell->isMarked = true;
+            return;
+        }
+        cut(cell, parent);
+        cell = parent;
+        parent = cell->parent;
+    }
+}
+
+/*
+ * Remove a cell from the circular list it is in, with reference to the
+ *   anchor cell of that list. If the anchor is the cell being removed, the
+ *   anchor moves on to its neighbor (or to NULL if the list is now empty).
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::removeCellFromList(
+        FCell<ValueType>* toRemove, FCell<ValueType>*& anchorCell) {
+    if (toRemove == toRemove->right) {
+        // the cell being removed has no siblings and is linked to itself
+        anchorCell = NULL;
+    } else {
+        // the cell being removed is referenced to itself
+        if(anchorCell == toRemove) {
+            anchorCell = anchorCell->right;
+        }
+        
+        // close the gap in the list left when a specific cell is
+        //   removed
+        toRemove->right->left = toRemove->left;
+        toRemove->left->right = toRemove->right;
+    }
+    toRemove->left = toRemove;
+    toRemove->right = toRemove;
+}
+
+/*
+ * Add a new cell as a neighbor to a specific anchor cell.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::addCellToList(
+        FCell<ValueType>* toAdd, FCell<ValueType>*& anchorCell) {
+    if (anchorCell == NULL) {
+        // anchor cell is empty, so link a cell to itself
+        toAdd->left = toAdd;
+        toAdd->right = toAdd;
+        anchorCell = toAdd;
+    } else {
+        // anchor cell is not empty, so insert it into the list next to
+        //   the anchor cell; adjust the pointers to the neighboring cells
+        toAdd->left = anchorCell;
+        toAdd->right = anchorCell->right;
+        anchorCell->right = toAdd;
+        toAdd->right->left = toAdd;
+    }
+}
+
+/*
+ * Consolidate the heap.
+ * This step ensures that heap tree never has two roots of the same degree.
+ *   In other words, ensure that each cell never has the same number of
+ *   children.
+
+http://www.cse.yorku.ca/~aaw/Jason/FibonacciHeapAlgorithm.html
+CONSOLIDATE(H)
+ for i:=0 to D(n[H])
+   Do A[i] := NIL
+
+ for each node w in the root list of H
+   do x:= w
+      d:= degree[x]
+      while A[d] <> NIL
+         do y:=A[d]
+            if key[x]>key[y]
+               then exchange x<->y
+            Fibonacci-Heap-Link(H, y, x)
+            A[d]:=NIL
+            d:=d+1
+      A[d]:=x
+
+ min[H]:=NIL
+ 
+ for i:=0 to D(n[H])
+     do if A[i]<> NIL
+        then add A[i] to the root list of H
+             if min[H] = NIL or key[A[i]]<key[min[H]]
+                then min[H]:= A[i]
+
+I relied especially heavily on the following code as an example implementation.
+http://wiki.openihs.org/Priority_queue_using_Fibonacci_heap
+ 
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::consolidate() {
+    /*
+     * The degree table keeps track of the root cell for any given cell
+     *   degree (i.e., cell rank -- i.e., number of children). This is
+     *   necessary because in the consolidate stage, we cannot have
+     *   any two groups of trees with the same degree.
+     *
+     * No root can have a degree larger than log_phi(n), so the table only
+     *   needs that many slots. It is kept between calls and every slot is
+     *   NULL on entry; rather than clearing and scanning one slot per cell
+     *   on every dequeue, we only walk the slots up to the largest degree
+     *   seen during this pass.
+     */
+    ensureDegreeTableCapacity();
+    Stats::countConsolidation();
+
+    FCell<ValueType>* rootListCell;
+    
+    // create a temporary variable to store the degree (i.e., num children)
+    int cellDegree;
+    
+    // the largest degree slot filled during this pass
+    int highestDegree = 0;
+    
+    // for each cell in the root node list (which we start by getting with
+    //   the firstCell pointer), get the degree of the root cell,
+    //   remove that from the list, capture the number of degrees,
+    //   and then iterate through those children swapping to ensure the
+    //   heap order is preserved where children are larger than their
+    //   parents
+    while (firstCell != NULL) {
+        rootListCell = firstCell;
+        removeCellFromList(rootListCell, firstCell);
+        
+        // get the degree of the current root list cell
+        cellDegree = rootListCell->degree;
+        
+        // as long as there is a cell of a specific degree, loop
+        //  through the root cells 
+        while (degreeTable[cellDegree] != NULL) {
+            // get the cell with the degree of the current root list
+            FCell<ValueType>* y;
+            y = degreeTable[cellDegree];
+            if (lessThan(y->value, rootListCell->value)) {
+                // swap the parent and child as the heap order has been
+                //   violated
+                FCell<ValueType>* temp;
+                temp = rootListCell;
+                rootListCell = y;
+                y = temp;
+            }
+
+            // y was taken out of the root list when it was entered into
+            //   the degree table, so it only needs to be linked in as a
+            //   child of the root list cell. A cell that becomes a child
+            //   starts out unmarked.
+            addCellToList(y, rootListCell->child);
+            y->parent = rootListCell;
+            y->isMarked = false;
+            Stats::countLink();
+            
+            // as the cell has been added to the child, the child's
+            //   degree needs to be incremented since it now has a new child
+            (rootListCell->degree)++;
+            
+            // as the tree has been adjusted, we clear the root cell
+            //   for a particular degree
+            degreeTable[cellDegree] = NULL;
+            
+            // as we have now checked everything in a specific degree,
+            //   we are ready to increment cell degree and check for the next
+            //   cell degree
+            cellDegree++;
+        }
+        
+        // store the new root cell for a given degree in the array
+        degreeTable[cellDegree] = rootListCell;
+        if (cellDegree > highestDegree) {
+            highestDegree = cellDegree;
+        }
+    }
+    
+    // since we have significantly adjusted the tree structure of the heap
+    //   and removed the minimum cell in dequeueMin, we now do not know
+    //   what is the minimum cell, so set the pointer that points
+    //   to the minimum value cell blank; we will find this value next
+    minCell = NULL;
+
+    /*
+     * Now that computing the root cell linked list is finished...
+     *   (1) for every cell identified as a root cell, add it to the
+     *         root linked list, which is done by adding it to the pointer
+     *         for the first cell (i.e., make it a sibling of the first cell).
+     *   (2) compute the proper pointer to the minimum cell by checking
+     *         whether each new cell added to the root is less than the
+     *         current minimum.
+     *   (3) clear the slot so the table is empty for the next pass.
+     */
+    for (int i = 0; i <= highestDegree; i++) {
+        // check if a valid head cell exists for a given degree
+        if (degreeTable[i] != NULL) {
+            // add the head of a tree to the root cell list by chaining it
+            //   to the first cell pointer
+            addCellToList(degreeTable[i], firstCell);
+            
+            // check whether the cell newly added to the root is the
+            //   smallest value
+            if(minCell == NULL || lessThan(degreeTable[i]->value, minCell->value)){
+                minCell = degreeTable[i];
+            }
+            degreeTable[i] = NULL;
+        }
+    }
+}
+
+/*
+ * Return the stats kept so far.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+const Stats& FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::stats() {
+    return *this;
+}
+
+/*
+ * Count the cells, or the whole pool if the heap owns it, and the degree
+ *   table that consolidate() reuses.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+MemoryUsage FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::memoryUsage() {
+    size_t totalBytes = sizeof(*this) + pool->bytesFor(numCells, pool == &ownPool);
+    totalBytes += degreeTableSize * sizeof(FCell<ValueType>*);
+    return MemoryUsage(numCells * sizeof(ValueType), totalBytes);
+}
+
+/*
+ * Compare two values with the comparator, counting the comparison in the
+ *   stats.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::lessThan(const ValueType& a, const ValueType& b) {
+    Stats::countComparison();
+    return isLess(a, b);
+}
+
+/*
+ * Make sure the degree table has a slot for every degree a root could
+ *   possibly have. A tree whose root has degree d holds at least F(d+2)
+ *   cells, where F is the Fibonacci sequence, so the maximum degree is
+ *   bounded by log_phi(n). The table is only reallocated when the heap
+ *   grows past what it can already hold.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::ensureDegreeTableCapacity() {
+    const double GOLDEN_RATIO = (1.0 + sqrt(5.0)) / 2.0;
+    int maxDegree = int(log(double(numCells)) / log(GOLDEN_RATIO)) + 2;
+    if (maxDegree < degreeTableSize) return;
+
+    delete[] degreeTable;
+    Stats::countResize();
+    degreeTableSize = maxDegree + 1;
+    degreeTable = new FCell<ValueType>*[degreeTableSize];
+    for (int i = 0; i < degreeTableSize; i++) {
+        degreeTable[i] = NULL;
+    }
+}
+
+/*
+ * Visually represent the heap and the connections of the cells in the heap.
+ * Function used for debugging.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::printHeap(FCell<ValueType>* anchorCell) {
+    // traverse all siblings
+    FCell<ValueType>* siblingCellToPrint = anchorCell;
+    while (siblingCellToPrint != NULL) {
+        
+        // print information about the current cell
+        cout << siblingCellToPrint->value
+             << " ID:" << siblingCellToPrint->cellIdNum
+             << " C:";
+        if (siblingCellToPrint->child == NULL) {
+            cout << "N";
+        } else {
+            cout << siblingCellToPrint->child->cellIdNum;
+        }
+        cout << " SL:" << siblingCellToPrint->left->cellIdNum
+             << " SR:" << siblingCellToPrint->right->cellIdNum;
+        cout << endl;
+
+        // traverse all children of the current cell
+        FCell<ValueType>* childToPrint = siblingCellToPrint->child;
+        if (childToPrint != NULL) {
+            // recursively print children
+            printHeap(childToPrint);
+        }
+        
+        // advance to the next sibling and check for the base case
+        siblingCellToPrint = siblingCellToPrint->right;
+        if (siblingCellToPrint == anchorCell)
+            return;
+    }
+}
+
+/*
+ * Visually represent the heap and the connections of the cells in the heap.
+ * Function used for debugging.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void FibonacciHeapPriorityQueue<ValueType, Compare, Stats>::printHeap() {
+    if (firstCell == NULL) {
+        cout << "tree is empty" << endl;
+        return;
+    }
+    printHeap(firstCell);
+}
+
 #endif
@@ -3,23 +3,64 @@
  *
  * Name: Eric Beach
  * Section: Dawson Zhou
- * A priority queue class backed by a binary heap.
+ * A priority queue class backed by a binary heap, or more generally by a
+ * d-ary heap where each cell has Arity children.
  */
 #ifndef PQueue_Heap_Included
 #define PQueue_Heap_Included
 
 #include <string>
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <iterator>
+#include <new>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include "simpio.h"
+#include "pqueue-stats.h"
+#include "pqueue-memoryusage.h"
+#include "error.h"
 using namespace std;
 
 /* A class representing a priority queue backed by an
- * binary heap.
+ * binary heap. Values are ordered by Compare, which defaults
+ * to operator<.
+ *
+ * Arity sets the number of children of each cell; 2 gives the usual
+ * binary heap. A wider heap is shallower, so a dequeue touches fewer
+ * levels at the price of more comparisons per level. Once the heap no
+ * longer fits in cache, each level costs a cache miss, so for large heaps
+ * a 4-ary or 8-ary heap is usually faster.
+ *
+ * The children of a cell are stored next to each other, and every group of
+ * siblings starts at an index that is a multiple of Arity. If
+ * AlignToCacheLine is set, the storage array starts on a cache line
+ * boundary, so whenever Arity * sizeof(ValueType) is a multiple of the
+ * cache line size each group of siblings occupies whole cache lines and
+ * finding the smallest child costs a single miss.
+ *
+ * Stats is the stats policy from pqueue-stats.h; with CountingStats the
+ * queue counts its comparisons, the moves of values between cells and the
+ * times its storage grows.
  */
-class HeapPriorityQueue {
+template <typename ValueType, typename Compare = less<ValueType>,
+          int Arity = 2, bool AlignToCacheLine = false, typename Stats = NoStats>
+class HeapPriorityQueue : private Stats {
+    static_assert(Arity >= 2, "A heap needs at least two children per cell");
+
 public:
 	/* Constructs a new, empty priority queue backed by a binary heap. */
-	HeapPriorityQueue();
+	explicit HeapPriorityQueue(Compare compare = Compare());
+
+	/* Constructs a priority queue holding the values in [begin, end). The
+	 * values are copied into storage with a single allocation and the heap
+	 * is then built in linear time. Pass move iterators to move them in.
+	 */
+	template <typename InputIterator>
+	HeapPriorityQueue(InputIterator begin, InputIterator end,
+	                  Compare compare = Compare());
 
 	/* Cleans up all memory allocated by this priority queue. */
 	~HeapPriorityQueue();
@@ -30,18 +71,56 @@ public:
 	/* Returns whether or not the priority queue is empty. */
 	bool isEmpty();
 
-	/* Enqueues a new string into the priority queue. */
-	void enqueue(string value);
+	/* Enqueues a copy of a value into the priority queue. */
+	void enqueue(const ValueType& value);
+
+	/* Enqueues a value into the priority queue, moving it into storage. */
+	void enqueue(ValueType&& value);
 
-	/* Returns, but does not remove, the lexicographically first string in the
-	 * priority queue.
+	/* Enqueues a value constructed in place from the given arguments. */
+	template <typename... Args>
+	void emplace(Args&&... args);
+
+	/* Enqueues every value in [begin, end). When many values are added at
+	 * once this is faster than enqueuing them one at a time.
 	 */
-	string peek();
-	
-	/* Returns and removes the lexicographically first string in the
-	 * priority queue.
+	template <typename InputIterator>
+	void enqueueAll(InputIterator begin, InputIterator end);
+
+	/* Makes room for at least n values, so that enqueuing up to n values
+	 * does not have to grow the storage again.
 	 */
-	string dequeueMin();
+	void reserve(int n);
+
+	/* Returns, but does not remove, the first value in the priority queue. */
+	const ValueType& peek();
+
+	/* Returns and removes the first value in the priority queue. */
+	ValueType dequeueMin();
+
+	/* Removes the k smallest values from the priority queue and writes them
+	 * to out in sorted order. Returns the output iterator one past the last
+	 * value written.
+	 */
+	template <typename OutputIterator>
+	OutputIterator dequeueMin(int k, OutputIterator out);
+
+	/* Removes every value from the priority queue. */
+	void clear();
+
+	/* Moves every value of other into this priority queue, leaving other
+	 * empty. The values are moved to the end of the array and the heap is
+	 * rebuilt as in enqueueAll(); no value is copied.
+	 */
+	void merge(HeapPriorityQueue& other);
+
+	/* Returns the stats the queue has kept so far. */
+	const Stats& stats();
+
+	/* Returns the bytes the heap takes, split into the values and the
+	 * overhead, which is mostly capacity allocated ahead of need.
+	 */
+	MemoryUsage memoryUsage();
 
 private:
     // Size of the queue
@@ -50,24 +129,559 @@ private:
     // Num of elements that have been allocated for storage (eg., max capacity)
     int allozatedSize;
 
-    // array of strings; used to store the data in the binary heap tree
-    string* storage;
-    
+    // array of values; used to store the data in the heap tree
+    ValueType* storage;
+
+    // the memory block the storage array was carved out of
+    void* rawStorage;
+
+    // comparator deciding which of two values comes first
+    Compare isLess;
+
     // initial capacity in the heap tree
     const int DEFAULT_CAPACITY = 32;
-    
+
+    // size in bytes of a cache line
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    // index of the root of the tree. The root is placed so that its
+    //   children start at index Arity; for the binary heap this is the
+    //   familiar 1-indexed layout with the children of i at 2i and 2i + 1.
+    static const int ROOT = Arity - 1;
+
+    // index of the first child and of the parent of a given cell
+    static int firstChild(int elemNum);
+    static int parent(int elemNum);
+
+    // compare two values, counting the comparison
+    bool lessThan(const ValueType& a, const ValueType& b);
+
     // expand the number of elements that can be stored
     void expandStorage();
-    
-    // bubble down from an element, therby ensuring that all children are
-    //   larger than their parent
-    void recursivelyBubbleDown(int elemNum);
-    
-    // swap elements
-    void swapElem(int elemNumA, int elemNumB);
+
+    // move the values into a new storage array with the given capacity
+    void resizeStorage(int capacity);
+
+    // refill the root after its value has been moved out
+    void fillRootHole();
+
+    // move the value in a cell up or down the tree to its proper place
+    void siftUp(int hole);
+    void siftDown(int hole);
+
+    // number of values in a range, or 0 if it cannot be known in advance
+    template <typename InputIterator>
+    static int rangeLength(InputIterator begin, InputIterator end,
+                           input_iterator_tag);
+    template <typename ForwardIterator>
+    static int rangeLength(ForwardIterator begin, ForwardIterator end,
+                           forward_iterator_tag);
+
+    // allocate an array of default-constructed values, aligned to a cache
+    //   line if AlignToCacheLine is set, and free it again
+    static ValueType* allocateStorage(int capacity, void*& rawMemory);
+    static void freeStorage(ValueType* array, int capacity, void* rawMemory);
 
     // print the tree, which is useful for debugging
     void printTree();
 };
 
+/*************************************************************
+ * Implementation of the HeapPriorityQueue class. Since the class is a
+ * template, the implementation has to be visible in the header.
+ */
+
+/*
+ * Constructor to initialize an array of values.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::HeapPriorityQueue(Compare compare)
+    : isLess(compare) {
+    // start with a default size, which can be expanded later
+    //   if the size of the heap grows
+    storage = allocateStorage(DEFAULT_CAPACITY, rawStorage);
+    allozatedSize = DEFAULT_CAPACITY;
+    listSize = 0;
+}
+
+/*
+ * Constructor to fill the heap from a range of values. If the length of the
+ *   range can be found up front, the storage is allocated once at the right
+ *   size rather than at the default size and then grown.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+template <typename InputIterator>
+HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::HeapPriorityQueue(InputIterator begin,
+                                                                                         InputIterator end,
+                                                                                         Compare compare)
+    : isLess(compare) {
+    int length = rangeLength(begin, end,
+                             typename iterator_traits<InputIterator>::iterator_category());
+    allozatedSize = max(DEFAULT_CAPACITY, ROOT + length);
+    storage = allocateStorage(allozatedSize, rawStorage);
+    listSize = 0;
+    enqueueAll(begin, end);
+}
+
+/*
+ * Destructor to deallocate memory for values.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::~HeapPriorityQueue() {
+    freeStorage(storage, allozatedSize, rawStorage);
+}
+
+/*
+ * Return the size of the queue.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+int HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::size() {
+    return listSize;
+}
+
+/*
+ * Return whether the queue is empty.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+bool HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::isEmpty() {
+    return (size() == 0);
+}
+
+/*
+ * Add a copy of a value to the queue.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+void HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::enqueue(const ValueType& value) {
+    emplace(value);
+}
+
+/*
+ * Add a value to the queue, moving it into the heap rather than copying it.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+void HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::enqueue(ValueType&& value) {
+    emplace(std::move(value));
+}
+
+/*
+ * Add a new value to the queue. Add it such that each parent is smaller
+ *   than its children. Parents are moved, not copied, down into the hole.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+template <typename... Args>
+void HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::emplace(Args&&... args) {
+    typename Stats::Timer timer(*this, STATS_ENQUEUE);
+    ValueType value(std::forward<Args>(args)...);
+
+    // Check whether underlying array needs to be expanded to store new elems
+    if (ROOT + listSize >= allozatedSize) {
+        expandStorage();
+    }
+
+    // Bubble Up
+    /*
+     Note: I do not strictly follow the assignment here in terms of how
+       to implement the Bubble Up. There is a slightly faster way to implement
+       this that I implemented as an extension. It does not require swapping
+       elements as the assignment's methodology does.
+       In performing speed tests, this method consistently performed a tad
+       faster. For "completeness", I have at the bottom of this function a
+       commmented-out implementation that is strictly according to the book
+       and passes all unit tests.
+
+     This insertion step works by starting at the bottom of the tree and
+       pulling down the tree to create room for the new cell at the proper
+       location, thereby requiring no swaps.
+     */
+    int nextLocation;
+    for (nextLocation = ROOT + listSize++;
+         nextLocation > ROOT && lessThan(value, storage[parent(nextLocation)]);
+         nextLocation = parent(nextLocation)) {
+        storage[nextLocation] = std::move(storage[parent(nextLocation)]);
+        Stats::countMoves(1);
+    }
+    /*
+     Since we have gone as far up the tree as we can such that the value
+       we are trying to insert is less than its child, we're at the place
+       we should now insert since going any further would cause a parent
+       to be larger than its child.
+     */
+    storage[nextLocation] = std::move(value);
+
+    /* Below is an implementation of Bubble Up that is structly according
+         to the assignment, for the binary heap.
+     int nextLocation;
+     nextLocation = ++listSize;
+     storage[nextLocation] = value;
+     for (nextLocation = listSize;
+          nextLocation > 1 && isLess(value, storage[nextLocation / 2]);
+          nextLocation /= 2) {
+         ValueType temp = storage[nextLocation / 2];
+         storage[nextLocation / 2] = storage[nextLocation];
+         storage[nextLocation] = temp;
+     }
+     */
+}
+
+/*
+ * Add a range of values to the queue.
+ *
+ * The values are first appended to the end of the array without regard to
+ *   order. If the range is large compared to the heap it joins, the whole
+ *   array is then rebuilt with Floyd's bottom-up heapify: every cell that
+ *   has children is sifted down, starting from the last one and working back
+ *   to the root. Most cells sit near the bottom of the tree and have little
+ *   distance to travel, so this takes O(n) time rather than the O(n log n)
+ *   of enqueuing the values one by one. If only a few values are added to a
+ *   big heap, sifting each of them up is cheaper than touching every cell,
+ *   so that is done instead.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+template <typename InputIterator>
+void HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::enqueueAll(InputIterator begin,
+                                                                                       InputIterator end) {
+    int length = rangeLength(begin, end,
+                             typename iterator_traits<InputIterator>::iterator_category());
+    reserve(listSize + length);
+
+    int oldSize = listSize;
+    for (; begin != end; ++begin) {
+        if (ROOT + listSize >= allozatedSize) {
+            expandStorage();
+        }
+        storage[ROOT + listSize++] = *begin;
+    }
+
+    // Sifting up each new value costs about one level per value, while the
+    //   heapify costs a constant per value in the whole heap, so only
+    //   heapify when the new values make up a large enough part of it.
+    int numAdded = listSize - oldSize;
+    int depth = 0;
+    for (int count = listSize; count > 0; count /= Arity) {
+        depth++;
+    }
+    int last = ROOT + listSize - 1;
+    if (numAdded * depth >= listSize) {
+        if (listSize > 1) {
+            for (int hole = parent(last); hole >= ROOT; hole--) {
+                siftDown(hole);
+            }
+        }
+    } else {
+        for (int hole = ROOT + oldSize; hole <= last; hole++) {
+            siftUp(hole);
+        }
+    }
+}
+
+/*
+ * Make sure the storage array can hold n values.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+void HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::reserve(int n) {
+    if (ROOT + n > allozatedSize) {
+        resizeStorage(ROOT + n);
+    }
+}
+
+/*
+ * Remove every element from the queue. The storage array keeps its
+ *   capacity, but the values in it are reset so they release any memory
+ *   they hold.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+void HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::clear() {
+    for (int i = ROOT; i < ROOT + listSize; i++) {
+        storage[i] = ValueType();
+    }
+    listSize = 0;
+}
+
+/*
+ * Merge another heap into this one by moving its values in with
+ *   enqueueAll(). The storage grows at most once, and the heap is rebuilt
+ *   or the new values sifted up, whichever is cheaper.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+void HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::merge(HeapPriorityQueue& other) {
+    if (&other == this || other.isEmpty()) return;
+    ValueType* otherValues = other.storage + ROOT;
+    enqueueAll(make_move_iterator(otherValues),
+               make_move_iterator(otherValues + other.listSize));
+    other.clear();
+}
+
+/*
+ * Return the smallest element in the queue.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+const ValueType& HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::peek() {
+    if (isEmpty()) error("no elements in queue");
+	return storage[ROOT];
+}
+
+/*
+ * Remove the smallest element in the queue and return it.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+ValueType HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::dequeueMin() {
+    typename Stats::Timer timer(*this, STATS_DEQUEUE);
+    if (isEmpty()) error("no elements in queue");
+    ValueType minElem = std::move(storage[ROOT]);
+    fillRootHole();
+
+    // Return min elem
+	return minElem;
+}
+
+/*
+ * Remove the k smallest elements in the queue, moving each one straight
+ *   from the root to the output and refilling the root with the same sift
+ *   that dequeueMin() uses.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+template <typename OutputIterator>
+OutputIterator HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::dequeueMin(int k, OutputIterator out) {
+    if (k < 0 || k > listSize) error("Cannot dequeue more values than the queue holds");
+    for (int i = 0; i < k; i++) {
+        *out++ = std::move(storage[ROOT]);
+        fillRootHole();
+    }
+    return out;
+}
+
+/*
+ * Refill the root once its value has been moved out, shrinking the heap
+ *   by one.
+ *
+ * This uses the same hole technique as enqueue(), run in the other
+ *   direction, and is the "bottom-up" variant of the sift-down (due to
+ *   Floyd). Removing the root leaves a hole at the top of the tree. Rather
+ *   than comparing the last element against all children at every level,
+ *   the hole is first walked all the way down to a leaf by always pulling
+ *   up the smallest child, which takes Arity - 1 comparisons per level. The last
+ *   element is then dropped into the hole and bubbled back up; since it
+ *   came from the bottom of the tree, it rarely has far to go. This takes
+ *   about half the comparisons of the textbook sift-down, which matters
+ *   when the values are strings, and moves each value at most once.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+void HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::fillRootHole() {
+    listSize--;
+    int end = ROOT + listSize;
+    ValueType lastElem = std::move(storage[end]);
+
+    // Walk the hole down to a leaf, pulling the smallest child up each time
+    int hole = ROOT;
+    for (int child = firstChild(hole); child < end; child = firstChild(hole)) {
+        int smallestChild = child;
+        int lastChild = min(child + Arity, end);
+        for (child++; child < lastChild; child++) {
+            if (lessThan(storage[child], storage[smallestChild])) {
+                smallestChild = child;
+            }
+        }
+        storage[hole] = std::move(storage[smallestChild]);
+        Stats::countMoves(1);
+        hole = smallestChild;
+    }
+
+    // Bubble the old last element back up from the leaf to its place
+    for (; hole > ROOT && lessThan(lastElem, storage[parent(hole)]);
+         hole = parent(hole)) {
+        storage[hole] = std::move(storage[parent(hole)]);
+        Stats::countMoves(1);
+    }
+    storage[hole] = std::move(lastElem);
+    Stats::countMoves(1);
+}
+
+/*
+ * Return the stats kept so far.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+const Stats& HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::stats() {
+    return *this;
+}
+
+/*
+ * Count the whole storage block: every slot it has room for, the unused
+ *   ones before the root included, and the slack left for aligning it.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+MemoryUsage HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::memoryUsage() {
+    size_t alignment = AlignToCacheLine ? CACHE_LINE_SIZE : alignof(ValueType);
+    size_t totalBytes = sizeof(*this) + allozatedSize * sizeof(ValueType) + alignment;
+    return MemoryUsage(listSize * sizeof(ValueType), totalBytes);
+}
+
+/*
+ * Compare two values with the comparator, counting the comparison in the
+ *   stats.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+bool HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::lessThan(const ValueType& a,
+                                                                                     const ValueType& b) {
+    Stats::countComparison();
+    return isLess(a, b);
+}
+
+/*
+ * Return the index of the first child of a cell. Its siblings follow it.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+int HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::firstChild(int elemNum) {
+    return Arity * (elemNum - Arity + 2);
+}
+
+/*
+ * Return the index of the parent of a cell.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+int HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::parent(int elemNum) {
+    return elemNum / Arity + Arity - 2;
+}
+
+/*
+ * Move a value up the tree until its parent is no larger than it is, using
+ *   the same hole technique as enqueue().
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+void HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::siftUp(int hole) {
+    ValueType value = std::move(storage[hole]);
+    for (; hole > ROOT && lessThan(value, storage[parent(hole)]);
+         hole = parent(hole)) {
+        storage[hole] = std::move(storage[parent(hole)]);
+        Stats::countMoves(1);
+    }
+    storage[hole] = std::move(value);
+}
+
+/*
+ * Move a value down the tree until none of its children is smaller than
+ *   it is. Unlike dequeueMin(), this stops as soon as the value is in
+ *   place: during a heapify the value usually belongs near where it starts,
+ *   so walking the hole all the way to a leaf first would waste work.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+void HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::siftDown(int hole) {
+    int end = ROOT + listSize;
+    ValueType value = std::move(storage[hole]);
+    for (int child = firstChild(hole); child < end; child = firstChild(hole)) {
+        int smallestChild = child;
+        int lastChild = min(child + Arity, end);
+        for (child++; child < lastChild; child++) {
+            if (lessThan(storage[child], storage[smallestChild])) {
+                smallestChild = child;
+            }
+        }
+        if (!lessThan(storage[smallestChild], value)) break;
+        storage[hole] = std::move(storage[smallestChild]);
+        Stats::countMoves(1);
+        hole = smallestChild;
+    }
+    storage[hole] = std::move(value);
+}
+
+/*
+ * Return 0 for a range that can only be walked once, since counting its
+ *   values would use them up.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+template <typename InputIterator>
+int HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::rangeLength(InputIterator,
+                                                                                       InputIterator,
+                                                                                       input_iterator_tag) {
+    return 0;
+}
+
+/*
+ * Return the number of values in a range that can be walked more than once.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+template <typename ForwardIterator>
+int HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::rangeLength(ForwardIterator begin,
+                                                                                       ForwardIterator end,
+                                                                                       forward_iterator_tag) {
+    return distance(begin, end);
+}
+
+/*
+ * Expand the capacity in the underlying storage array.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+void HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::expandStorage() {
+    resizeStorage(allozatedSize * 2);
+}
+
+/*
+ * Move the values into a new storage array of the given capacity.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+void HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::resizeStorage(int capacity) {
+    void* rawTemp;
+    ValueType* temp = allocateStorage(capacity, rawTemp);
+    std::move(storage + ROOT, storage + ROOT + listSize, temp + ROOT);
+    Stats::countResize();
+    Stats::countMoves(listSize);
+    freeStorage(storage, allozatedSize, rawStorage);
+    storage = temp;
+    rawStorage = rawTemp;
+    allozatedSize = capacity;
+}
+
+/*
+ * Allocate a storage array. This does the work of new[], except that the
+ *   array can be placed on a cache line boundary: a block a little larger
+ *   than needed is allocated and the array starts at the first suitably
+ *   aligned address inside it.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+ValueType* HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::allocateStorage(int capacity, void*& rawMemory) {
+    size_t alignment = AlignToCacheLine ? CACHE_LINE_SIZE : alignof(ValueType);
+    rawMemory = ::operator new(capacity * sizeof(ValueType) + alignment);
+
+    uintptr_t address = reinterpret_cast<uintptr_t>(rawMemory);
+    address = (address + alignment - 1) / alignment * alignment;
+    ValueType* array = reinterpret_cast<ValueType*>(address);
+    for (int i = 0; i < capacity; i++) {
+        new (array + i) ValueType();
+    }
+    return array;
+}
+
+/*
+ * Destroy the values in a storage array and free its memory.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+void HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::freeStorage(ValueType* array, int capacity, void* rawMemory) {
+    for (int i = 0; i < capacity; i++) {
+        array[i].~ValueType();
+    }
+    ::operator delete(rawMemory);
+}
+
+/*
+ * Print the heap tree, which is useful for debugging.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+void HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>::printTree() {
+    cout << "List Size: " << listSize << endl;
+    int end = ROOT + listSize;
+    for (int rowStart = ROOT, rowLength = 1; rowStart < end;
+         rowStart = firstChild(rowStart), rowLength *= Arity) {
+        string space = "";
+        int numSpaces = 40 / rowLength;
+        for (int s = 0; s < numSpaces; s++) {
+            space += " ";
+        }
+        cout << space;
+        int rowEnd = rowStart + rowLength;
+        for (int i = rowStart; i < rowEnd && i < end; i++) {
+            cout << i << ", " << storage[i] << space << space;
+        }
+        cout << endl;
+    }
+}
+
 #endif
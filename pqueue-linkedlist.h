@@ -10,56 +10,377 @@
 #define PQueue_LinkedList_Included
 
 #include <string>
+#include <functional>
+#include <utility>
+#include "pqueue-nodepool.h"
+#include "error.h"
+#include "pqueue-stats.h"
+#include "pqueue-memoryusage.h"
+
+// used for debugging code
+#include <iostream>
+#include "simpio.h"
 using namespace std;
 
 /* Type: Cell
  * A cell in a linked list.
  */
+template <typename ValueType>
 struct Cell {
-	string value;
+	ValueType value;
 	Cell* next = NULL;
+
+	/* Constructs the value in place from the given arguments. */
+	template <typename... Args>
+	explicit Cell(Args&&... args) : value(std::forward<Args>(args)...) {}
 };
 
 /* A class representing a priority queue backed by a sorted,
- * singly-linked list.
+ * singly-linked list. Values are ordered by Compare, which defaults
+ * to operator<. Stats is a stats policy from pqueue-stats.h; the list
+ * relinks cells rather than moving values, so only its comparisons are
+ * counted.
  */
-class LinkedListPriorityQueue {
+template <typename ValueType, typename Compare = less<ValueType>, typename Stats = NoStats>
+class LinkedListPriorityQueue : private Stats {
 public:
 	/* Constructs a new, empty priority queue backed by a sorted linked list. */
-	LinkedListPriorityQueue();
-	
+	explicit LinkedListPriorityQueue(Compare compare = Compare());
+
+	/* The pool that the cells of this kind of queue are allocated from. */
+	typedef NodePool<Cell<ValueType> > Pool;
+
+	/* Constructs a new, empty priority queue that allocates its cells from
+	 * a pool shared with other queues. The pool must outlive the queue.
+	 */
+	explicit LinkedListPriorityQueue(Pool& sharedPool, Compare compare = Compare());
+
 	/* Cleans up all memory allocated by this priority queue. */
 	~LinkedListPriorityQueue();
-	
+
 	/* Returns the number of elements in the priority queue. */
 	int size();
-	
+
 	/* Returns whether or not the priority queue is empty. */
 	bool isEmpty();
-	
-	/* Enqueues a new string into the priority queue. */
-	void enqueue(string value);
-	
-	/* Returns, but does not remove, the lexicographically first string in the
-	 * priority queue.
+
+	/* Enqueues a copy of a value into the priority queue. */
+	void enqueue(const ValueType& value);
+
+	/* Enqueues a value into the priority queue, moving it into storage. */
+	void enqueue(ValueType&& value);
+
+	/* Enqueues a value constructed in place from the given arguments. */
+	template <typename... Args>
+	void emplace(Args&&... args);
+
+	/* Returns, but does not remove, the first value in the priority queue. */
+	const ValueType& peek();
+
+	/* Returns and removes the first value in the priority queue. */
+	ValueType dequeueMin();
+
+	/* Removes the k smallest values from the priority queue and writes them
+	 * to out in sorted order. Returns the output iterator one past the last
+	 * value written.
+	 */
+	template <typename OutputIterator>
+	OutputIterator dequeueMin(int k, OutputIterator out);
+
+	/* Removes every value from the priority queue. */
+	void clear();
+
+	/* Moves every value of other into this priority queue, leaving other
+	 * empty. The two sorted lists are merged in linear time and no value is
+	 * copied.
 	 */
-	string peek();
-	
-	/* Returns and removes the lexicographically first string in the
-	 * priority queue.
+	void merge(LinkedListPriorityQueue& other);
+
+	/* Returns the stats the queue has kept so far. */
+	const Stats& stats();
+
+	/* Returns the bytes the queue takes, split into the values and the
+	 * overhead of the cells holding them. A queue that owns its pool counts
+	 * all of it, including cells given back and not reused yet; a queue that
+	 * shares its pool counts only its own cells.
 	 */
-	string dequeueMin();
+	MemoryUsage memoryUsage();
 
 private:
     // Linked list
-    Cell* list;
+    Cell<ValueType>* list;
 
     // Size of the linked list. Instance variable used to store this so that
     //   size can operate in O(1) and not have to traverse the entire list.
     int listSize;
 
+    // comparator deciding which of two values comes first
+    Compare isLess;
+
+    // compare two values, counting the comparison
+    bool lessThan(const ValueType& a, const ValueType& b);
+
+    // pool used when the queue is not given one to share, and the pool
+    //   that the cells actually come from
+    Pool ownPool;
+    Pool* pool;
+
     // helper function useful for debugging
     void printLinkedList();
 };
 
+/*************************************************************
+ * Implementation of the LinkedListPriorityQueue class. Since the class is
+ * a template, the implementation has to be visible in the header.
+ */
+
+/*
+ * Constructor to start the list empty and initialize the list size as empty.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+LinkedListPriorityQueue<ValueType, Compare, Stats>::LinkedListPriorityQueue(Compare compare)
+    : isLess(compare) {
+    list = NULL;
+    listSize = 0;
+    pool = &ownPool;
+}
+
+/*
+ * Constructor to start the list empty, taking its cells from a shared pool.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+LinkedListPriorityQueue<ValueType, Compare, Stats>::LinkedListPriorityQueue(Pool& sharedPool, Compare compare)
+    : isLess(compare) {
+    list = NULL;
+    listSize = 0;
+    pool = &sharedPool;
+}
+
+/*
+ * Destructor to empty the queue and deallocate memory.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+LinkedListPriorityQueue<ValueType, Compare, Stats>::~LinkedListPriorityQueue() {
+    clear();
+}
+
+/*
+ * Return the size of the list.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int LinkedListPriorityQueue<ValueType, Compare, Stats>::size() {
+    return listSize;
+}
+
+/*
+ * Return whether the current queue is empty.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool LinkedListPriorityQueue<ValueType, Compare, Stats>::isEmpty() {
+	return (size() == 0);
+}
+
+/*
+ * Add a copy of a value to the queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void LinkedListPriorityQueue<ValueType, Compare, Stats>::enqueue(const ValueType& value) {
+    emplace(value);
+}
+
+/*
+ * Add a value to the queue, moving it into its cell rather than copying it.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void LinkedListPriorityQueue<ValueType, Compare, Stats>::enqueue(ValueType&& value) {
+    emplace(std::move(value));
+}
+
+/*
+ * Add a new element to the queue and place it at the proper sorted location.
+ *   The value is constructed directly inside its new cell.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename... Args>
+void LinkedListPriorityQueue<ValueType, Compare, Stats>::emplace(Args&&... args) {
+    typename Stats::Timer timer(*this, STATS_ENQUEUE);
+    Cell<ValueType>* newCell = pool->create(std::forward<Args>(args)...);
+
+    // since the assignment requires storing in a sorted, singly linked
+    //   list, inserting the new cell requires finding the proper location
+    //   to insert the new cell, which requires traversing the list
+    if (listSize == 0) {
+        list = newCell;
+    } else if (lessThan(newCell->value, list->value)) {
+        Cell<ValueType>* temp = newCell;
+        temp->next = list;
+        list = temp;
+    } else {
+        Cell<ValueType>* curr = list;
+        Cell<ValueType>* last;
+        do {
+            last = curr;
+            curr = curr->next;
+        } while (curr != NULL && lessThan(curr->value, newCell->value));
+
+        newCell->next = last->next;
+        last->next = newCell;
+    }
+    listSize++;
+}
+
+/*
+ * Look at the smallest element in the queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+const ValueType& LinkedListPriorityQueue<ValueType, Compare, Stats>::peek() {
+	if (isEmpty()) error("Cannot peek at an empty list");
+	return list->value;
+}
+
+/*
+ * Remove the smallest element from the queue and return it to the caller.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+ValueType LinkedListPriorityQueue<ValueType, Compare, Stats>::dequeueMin() {
+    typename Stats::Timer timer(*this, STATS_DEQUEUE);
+	if (isEmpty()) error("Cannot peek at an empty list");
+    Cell<ValueType>* currentSmallest = list;
+    ValueType val = std::move(currentSmallest->value);
+    Cell<ValueType>* nextSmallest = list->next;
+    list = nextSmallest;
+
+    // give the cell back to the pool so it can be reused
+    pool->destroy(currentSmallest);
+    listSize--;
+	return val;
+}
+
+/*
+ * Remove the k smallest elements from the queue. Since the list is sorted,
+ *   these are exactly its first k cells, so the prefix is walked once and
+ *   the rest of the list is reattached in a single step.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename OutputIterator>
+OutputIterator LinkedListPriorityQueue<ValueType, Compare, Stats>::dequeueMin(int k, OutputIterator out) {
+    if (k < 0 || k > listSize) error("Cannot dequeue more values than the list holds");
+    Cell<ValueType>* curr = list;
+    for (int i = 0; i < k; i++) {
+        Cell<ValueType>* next = curr->next;
+        *out++ = std::move(curr->value);
+        pool->destroy(curr);
+        curr = next;
+    }
+    list = curr;
+    listSize -= k;
+    return out;
+}
+
+/*
+ * Remove every element from the queue, walking the list once and giving
+ *   each cell back to the pool.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void LinkedListPriorityQueue<ValueType, Compare, Stats>::clear() {
+    Cell<ValueType>* curr = list;
+    while (curr != NULL) {
+        Cell<ValueType>* next = curr->next;
+        pool->destroy(curr);
+        curr = next;
+    }
+    list = NULL;
+    listSize = 0;
+}
+
+/*
+ * Merge the sorted list of another queue into this one, the same way merge
+ *   sort merges two sorted runs. On ties, values already in this queue come
+ *   first.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void LinkedListPriorityQueue<ValueType, Compare, Stats>::merge(LinkedListPriorityQueue& other) {
+    if (&other == this || other.isEmpty()) return;
+
+    Cell<ValueType>* otherList = other.list;
+    if (!takeOverCells(pool, other.pool, other.pool == &other.ownPool)) {
+        // the other cells belong to a pool this queue cannot take over, so
+        //   move each value into a cell of this queue's pool, in order
+        Cell<ValueType>* moved = NULL;
+        Cell<ValueType>** movedEnd = &moved;
+        for (Cell<ValueType>* curr = otherList; curr != NULL; ) {
+            Cell<ValueType>* next = curr->next;
+            *movedEnd = pool->create(std::move(curr->value));
+            movedEnd = &(*movedEnd)->next;
+            other.pool->destroy(curr);
+            curr = next;
+        }
+        otherList = moved;
+    }
+
+    Cell<ValueType>* merged = NULL;
+    Cell<ValueType>** mergedEnd = &merged;
+    Cell<ValueType>* first = list;
+    Cell<ValueType>* second = otherList;
+    while (first != NULL && second != NULL) {
+        if (lessThan(second->value, first->value)) {
+            *mergedEnd = second;
+            second = second->next;
+        } else {
+            *mergedEnd = first;
+            first = first->next;
+        }
+        mergedEnd = &(*mergedEnd)->next;
+    }
+    *mergedEnd = (first != NULL) ? first : second;
+
+    list = merged;
+    listSize += other.listSize;
+    other.list = NULL;
+    other.listSize = 0;
+}
+
+/*
+ * Helper function used for debugging.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void LinkedListPriorityQueue<ValueType, Compare, Stats>::printLinkedList() {
+    cout << "going to print linked list of size " << listSize << endl;
+    for (Cell<ValueType>* current = list;
+         current != NULL;
+         current = current->next) {
+        if (current != NULL) {
+            cout << "printing: " << current->value << endl;
+        }
+    }
+    cout << "finished printing linked list of size " << listSize << endl;
+}
+
+/*
+ * Return the stats kept so far.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+const Stats& LinkedListPriorityQueue<ValueType, Compare, Stats>::stats() {
+    return *this;
+}
+
+/*
+ * Count the cells, or the whole pool if the queue owns it.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+MemoryUsage LinkedListPriorityQueue<ValueType, Compare, Stats>::memoryUsage() {
+    size_t totalBytes = sizeof(*this) + pool->bytesFor(listSize, pool == &ownPool);
+    return MemoryUsage(listSize * sizeof(ValueType), totalBytes);
+}
+
+/*
+ * Compare two values with the comparator, counting the comparison in the
+ *   stats.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool LinkedListPriorityQueue<ValueType, Compare, Stats>::lessThan(const ValueType& a, const ValueType& b) {
+    Stats::countComparison();
+    return isLess(a, b);
+}
+
 #endif
@@ -0,0 +1,713 @@
+/**********************************************
+ * File: pqueue-lockfreeskiplist.h
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * A priority queue class backed by a lock-free skip list, following
+ *   Lindén and Jonsson ("A Skiplist-Based Concurrent Priority Queue with
+ *   Minimal Memory Contention", 2013).
+ *
+ * Like the SkipListPriorityQueue, the values are kept in a sorted skip
+ *   list, but no thread ever takes a lock. All links are atomic and are
+ *   changed with compare-and-swap, so a thread that is delayed in the
+ *   middle of an operation never holds up the others.
+ *
+ * The smallest values are at the front of the list, so a naive delete
+ *   would have every thread fight over the first few links. Instead, a
+ *   dequeue deletes a value only logically, by setting the lowest bit of
+ *   the link that points to it. The deleted values therefore always form
+ *   a prefix of the list, and a dequeue walks past the marked links to
+ *   the first unmarked one and marks it with a single fetch-and-or. Only
+ *   once the deleted prefix is longer than BOUND_OFFSET does one thread
+ *   cut the whole prefix off at once by moving the head's links, so the
+ *   head is written once per batch of deletions rather than once per
+ *   deletion.
+ *
+ * Deleted cells may still be looked at by other threads, so they cannot
+ *   be freed right away. They are reclaimed by epochs (Fraser, "Practical
+ *   lock-freedom", 2004): the queue keeps a global epoch, and a thread
+ *   running an operation announces the epoch it started in, in a slot of
+ *   its own on its own cache line. Cells cut off the list are retired into
+ *   the list of the current epoch. The epoch only moves on once every
+ *   running operation has announced it, so once it has moved on twice no
+ *   operation can still see the cells retired in it, and they are freed.
+ *   Retired memory is thus bounded by the cells cut off in three epochs,
+ *   however long the queue runs, and an operation only ever writes to its
+ *   own slot to enter and leave.
+ */
+#ifndef PQueue_LockFreeSkipList_Included
+#define PQueue_LockFreeSkipList_Included
+
+#include <string>
+#include <functional>
+#include <utility>
+#include <new>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <cstdint>
+#include <type_traits>
+#include "error.h"
+#include "pqueue-stats.h"
+#include "pqueue-memoryusage.h"
+using namespace std;
+
+/* Type: LockFreeSkipCell
+ * A cell in a lock-free skip list. The cell is followed in memory by an
+ * array of atomic links to the next cell on each level; level 0 links
+ * every cell. The lowest bit of a level 0 link is set once the cell it
+ * points to has been deleted. The value is only constructed for cells
+ * that hold one, and not for the head and tail of the list.
+ */
+template <typename ValueType>
+struct alignas(void*) alignas(ValueType) LockFreeSkipCell {
+	typename aligned_storage<sizeof(ValueType), alignof(ValueType)>::type storage;
+
+	// number of levels this cell is linked into
+	int level;
+
+	// set while the insert that created the cell is still linking it into
+	//   the higher levels
+	atomic<bool> inserting;
+
+	// next cell in the list of retired cells
+	LockFreeSkipCell* nextRetired;
+
+	/* Returns the value stored in the cell. */
+	ValueType& value() {
+		return *reinterpret_cast<ValueType*>(&storage);
+	}
+
+	/* Returns the array of links that follows the cell. */
+	atomic<uintptr_t>* next() {
+		return reinterpret_cast<atomic<uintptr_t>*>(this + 1);
+	}
+};
+
+/* A class representing a priority queue backed by a lock-free skip list.
+ * Values are ordered by Compare, which defaults to operator<.
+ *
+ * All operations may be called from several threads at once, and values
+ * come out in sorted order. Since the queue can change between two calls,
+ * a consumer should use tryDequeueMin() rather than isEmpty() followed by
+ * dequeueMin(). Because deleted cells may still be compared against by
+ * other threads, dequeueMin() and peek() return a copy of the value.
+ *
+ * Stats is a stats policy from pqueue-stats.h. Every thread updates the
+ * same CountingStats; comparisons made while retrying a failed insert are
+ * counted too, so under contention the count shows the work wasted.
+ */
+template <typename ValueType, typename Compare = less<ValueType>, typename Stats = NoStats>
+class LockFreeSkipListPriorityQueue : private Stats {
+public:
+	/* Constructs a new, empty priority queue ordered by the given comparator. */
+	explicit LockFreeSkipListPriorityQueue(Compare compare = Compare());
+
+	/* Cleans up all memory allocated by this priority queue. No other thread
+	 * may be using the queue any more.
+	 */
+	~LockFreeSkipListPriorityQueue();
+
+	/* Returns the number of elements in the priority queue. */
+	int size();
+
+	/* Returns whether or not the priority queue is empty. */
+	bool isEmpty();
+
+	/* Enqueues a copy of a value into the priority queue. */
+	void enqueue(const ValueType& value);
+
+	/* Enqueues a value into the priority queue, moving it into storage. */
+	void enqueue(ValueType&& value);
+
+	/* Enqueues a value constructed in place from the given arguments. */
+	template <typename... Args>
+	void emplace(Args&&... args);
+
+	/* Returns a copy of, but does not remove, the first value in the
+	 * priority queue.
+	 */
+	ValueType peek();
+
+	/* Returns and removes the first value in the priority queue. */
+	ValueType dequeueMin();
+
+	/* Removes the first value in the priority queue and copies it into
+	 * result. Returns false, leaving result alone, if the queue is empty.
+	 */
+	bool tryDequeueMin(ValueType& result);
+
+	/* Removes the k smallest values from the priority queue and writes them
+	 * to out in sorted order. Returns the output iterator one past the last
+	 * value written. The values are removed one at a time, so other threads
+	 * may remove values in between.
+	 */
+	template <typename OutputIterator>
+	OutputIterator dequeueMin(int k, OutputIterator out);
+
+	/* Removes every value from the priority queue. */
+	void clear();
+
+	/* Moves every value of other into this priority queue, leaving other
+	 * empty. The values are moved one at a time.
+	 */
+	void merge(LockFreeSkipListPriorityQueue& other);
+
+	/* Returns the stats the queue has kept so far. */
+	const Stats& stats();
+
+	/* Returns the bytes the list takes, split into the values and the
+	 * overhead of their cells and links, of the head and tail, and of the
+	 * deleted cells not freed yet. This walks the list and takes linear time;
+	 * no other thread may be using the queue while it runs.
+	 */
+	MemoryUsage memoryUsage();
+
+private:
+	typedef LockFreeSkipCell<ValueType> Cell;
+
+	// highest number of levels a cell can have
+	static const int MAX_LEVEL = 16;
+
+	// number of deleted cells the list may start with before they are cut off
+	static const int BOUND_OFFSET = 32;
+
+	// sentinel cells before the first and after the last value
+	Cell* head;
+	Cell* tail;
+
+	// number of values not yet deleted
+	atomic<int> numValues;
+
+	// number of slots in which running operations announce their epoch; if
+	//   more threads than this run at once, the extra ones wait for a slot
+	static const int EPOCH_SLOTS = 64;
+
+	// value of a slot that no operation is using
+	static const uint64_t IDLE = 0;
+
+	// a slot announcing the epoch an operation started in, on a cache line
+	//   of its own so that threads entering and leaving do not contend
+	struct alignas(64) EpochSlot {
+		atomic<uint64_t> epoch;
+	};
+
+	// the global epoch, which starts at 1, and the slots of the operations
+	//   running in it
+	atomic<uint64_t> globalEpoch;
+	EpochSlot epochSlots[EPOCH_SLOTS];
+
+	// cells cut off the list, by the epoch they were retired in modulo 3
+	atomic<Cell*> retired[3];
+
+	// comparator deciding which of two values comes first
+	Compare isLess;
+
+	// announces the current epoch for as long as it is in scope
+	class OperationGuard {
+	public:
+		explicit OperationGuard(LockFreeSkipListPriorityQueue* queue) : queue(queue) {
+			slot = queue->beginOperation();
+		}
+		~OperationGuard() {
+			queue->epochSlots[slot].epoch.store(IDLE, memory_order_release);
+		}
+	private:
+		LockFreeSkipListPriorityQueue* queue;
+		int slot;
+	};
+
+	// helpers for the deletion mark in the lowest bit of a link
+	static bool isMarked(uintptr_t link) { return (link & 1) != 0; }
+	static Cell* unmarked(uintptr_t link) { return reinterpret_cast<Cell*>(link & ~uintptr_t(1)); }
+	static uintptr_t marked(Cell* cell) { return reinterpret_cast<uintptr_t>(cell) | 1; }
+	static uintptr_t linkTo(Cell* cell) { return reinterpret_cast<uintptr_t>(cell); }
+
+	// whether a cell comes before a value; the tail comes after everything
+	bool isBefore(Cell* cell, const ValueType& value);
+
+	// choose a random number of levels for a new cell
+	static int randomLevel();
+
+	// allocate a cell with the given number of levels, without a value
+	static Cell* createCell(int level);
+
+	// free a cell, destroying its value if it has one
+	static void destroyCell(Cell* cell, bool hasValue);
+
+	// find the cells a value goes between on each level, and return the last
+	//   deleted cell seen on level 0, if any
+	Cell* locatePreds(const ValueType& value, Cell** preds, Cell** succs);
+
+	// move the head's higher links past the deleted cells
+	void restructure();
+
+	// add a chain of cells, linked through nextRetired, to the retired list
+	//   of the current epoch
+	void retire(Cell* first, Cell* last);
+
+	// claim an idle slot and announce the current epoch in it, returning
+	//   the number of the slot
+	int beginOperation();
+
+	// move the epoch on if every running operation has announced it, and
+	//   free the cells retired two epochs ago
+	void tryAdvanceEpoch();
+
+	// free a chain of retired cells
+	static void destroyRetired(Cell* cell);
+
+	// disallow copying, since the cells are shared between threads
+	LockFreeSkipListPriorityQueue(const LockFreeSkipListPriorityQueue&);
+	LockFreeSkipListPriorityQueue& operator=(const LockFreeSkipListPriorityQueue&);
+};
+
+/*************************************************************
+ * Implementation of the LockFreeSkipListPriorityQueue class. Since the
+ * class is a template, the implementation has to be visible in the header.
+ */
+
+/*
+ * Constructor to link the head to the tail on every level.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::LockFreeSkipListPriorityQueue(Compare compare)
+    : numValues(0), globalEpoch(1), isLess(compare) {
+    for (int i = 0; i < EPOCH_SLOTS; i++) {
+        epochSlots[i].epoch.store(IDLE);
+    }
+    for (int i = 0; i < 3; i++) {
+        retired[i].store(NULL);
+    }
+    head = createCell(MAX_LEVEL);
+    tail = createCell(MAX_LEVEL);
+    for (int i = 0; i < MAX_LEVEL; i++) {
+        head->next()[i].store(linkTo(tail));
+        tail->next()[i].store(0);
+    }
+}
+
+/*
+ * Destructor to free every cell still in the list and every retired cell.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::~LockFreeSkipListPriorityQueue() {
+    Cell* cell = unmarked(head->next()[0].load());
+    while (cell != tail) {
+        Cell* next = unmarked(cell->next()[0].load());
+        destroyCell(cell, true);
+        cell = next;
+    }
+    for (int i = 0; i < 3; i++) {
+        destroyRetired(retired[i].load());
+    }
+    destroyCell(head, false);
+    destroyCell(tail, false);
+}
+
+/*
+ * Return the current size of the queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::size() {
+    return numValues.load();
+}
+
+/*
+ * Return whether the queue is empty.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::isEmpty() {
+    return (size() == 0);
+}
+
+/*
+ * Add a copy of a value to the queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::enqueue(const ValueType& value) {
+    emplace(value);
+}
+
+/*
+ * Add a value to the queue without copying it.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::enqueue(ValueType&& value) {
+    emplace(std::move(value));
+}
+
+/*
+ * Add a value to the list. The new cell is first linked in on level 0,
+ *   which is what makes the value part of the queue, and then on each of
+ *   its higher levels in turn. If a link has changed in the meantime, the
+ *   place is searched for again. The higher links are only shortcuts, so
+ *   the insert gives up on them as soon as the new cell or the cell after
+ *   it is deleted.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename... Args>
+void LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::emplace(Args&&... args) {
+    typename Stats::Timer timer(*this, STATS_ENQUEUE);
+    int level = randomLevel();
+    Cell* newCell = createCell(level);
+    try {
+        new (&newCell->storage) ValueType(std::forward<Args>(args)...);
+    } catch (...) {
+        destroyCell(newCell, false);
+        throw;
+    }
+    newCell->inserting.store(true);
+
+    OperationGuard guard(this);
+    Cell* preds[MAX_LEVEL];
+    Cell* succs[MAX_LEVEL];
+    Cell* deleted;
+    while (true) {
+        deleted = locatePreds(newCell->value(), preds, succs);
+        newCell->next()[0].store(linkTo(succs[0]));
+        uintptr_t expected = linkTo(succs[0]);
+        if (preds[0]->next()[0].compare_exchange_strong(expected, linkTo(newCell))) break;
+    }
+    numValues++;
+
+    int i = 1;
+    while (i < level) {
+        newCell->next()[i].store(linkTo(succs[i]));
+        if (isMarked(newCell->next()[0].load()) || isMarked(succs[i]->next()[0].load()) ||
+            deleted == succs[i]) {
+            break;
+        }
+        uintptr_t expected = linkTo(succs[i]);
+        if (preds[i]->next()[i].compare_exchange_strong(expected, linkTo(newCell))) {
+            i++;
+        } else {
+            deleted = locatePreds(newCell->value(), preds, succs);
+            if (succs[0] != newCell) break;
+        }
+    }
+    newCell->inserting.store(false);
+}
+
+/*
+ * Look at the value in the first cell that has not been deleted.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+ValueType LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::peek() {
+    OperationGuard guard(this);
+    Cell* cell = head;
+    while (true) {
+        uintptr_t next = cell->next()[0].load();
+        if (unmarked(next) == tail) break;
+        if (!isMarked(next)) return unmarked(next)->value();
+        cell = unmarked(next);
+    }
+    error("The queue is empty");
+    return ValueType();
+}
+
+/*
+ * Remove and return the smallest value in the queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+ValueType LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::dequeueMin() {
+    ValueType result;
+    if (!tryDequeueMin(result)) error("The queue is empty");
+    return result;
+}
+
+/*
+ * Walk past the deleted prefix of the list and delete the first value by
+ *   marking the link to it. If the prefix has grown longer than
+ *   BOUND_OFFSET, it is cut off by pointing the head past it, but never
+ *   past a cell that is still being inserted, since that insert may be
+ *   about to link it in on a higher level. The cells cut off are retired.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::tryDequeueMin(ValueType& result) {
+    typename Stats::Timer timer(*this, STATS_DEQUEUE);
+    OperationGuard guard(this);
+    Cell* cell = head;
+    Cell* newHead = NULL;
+    int offset = 0;
+    uintptr_t observedHead = head->next()[0].load();
+    uintptr_t next;
+    do {
+        next = cell->next()[0].load();
+        if (unmarked(next) == tail) return false;
+        if (newHead == NULL && cell->inserting.load()) newHead = cell;
+        next = cell->next()[0].fetch_or(1);
+        offset++;
+        cell = unmarked(next);
+    } while (isMarked(next));
+
+    result = cell->value();
+    numValues--;
+    if (newHead == NULL) newHead = cell;
+
+    if (offset <= BOUND_OFFSET) return true;
+    if (head->next()[0].load() != observedHead) return true;
+    if (head->next()[0].compare_exchange_strong(observedHead, marked(newHead))) {
+        restructure();
+        Cell* first = unmarked(observedHead);
+        if (first != newHead) {
+            Cell* last = first;
+            while (unmarked(last->next()[0].load()) != newHead) {
+                Cell* next = unmarked(last->next()[0].load());
+                last->nextRetired = next;
+                last = next;
+            }
+            retire(first, last);
+        }
+    }
+    return true;
+}
+
+/*
+ * Remove the k smallest elements from the queue one at a time.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename OutputIterator>
+OutputIterator LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::dequeueMin(int k, OutputIterator out) {
+    if (k < 0 || k > size()) error("Cannot dequeue more values than the queue holds");
+
+    for (int i = 0; i < k; i++) {
+        *out++ = dequeueMin();
+    }
+    return out;
+}
+
+/*
+ * Remove every element from the queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::clear() {
+    ValueType discarded;
+    while (tryDequeueMin(discarded)) {
+    }
+}
+
+/*
+ * Merge another queue into this one by moving its values over one at a
+ *   time.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::merge(LockFreeSkipListPriorityQueue& other) {
+    if (&other == this) return;
+    ValueType value;
+    while (other.tryDequeueMin(value)) {
+        emplace(std::move(value));
+    }
+}
+
+/*
+ * Check whether a cell comes before a value.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::isBefore(Cell* cell, const ValueType& value) {
+    if (cell == tail) return false;
+    Stats::countComparison();
+    return isLess(cell->value(), value);
+}
+
+/*
+ * Choose a level the same way as the SkipListPriorityQueue, with a
+ *   generator of the calling thread's own.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::randomLevel() {
+    static thread_local minstd_rand random(hash<thread::id>()(this_thread::get_id()));
+    int level = 1;
+    while (level < MAX_LEVEL && random() % 4 == 0) {
+        level++;
+    }
+    return level;
+}
+
+/*
+ * Allocate a cell with room for its links right behind it.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+typename LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::Cell*
+LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::createCell(int level) {
+    void* memory = ::operator new(sizeof(Cell) + level * sizeof(atomic<uintptr_t>));
+    Cell* cell = static_cast<Cell*>(memory);
+    cell->level = level;
+    new (&cell->inserting) atomic<bool>(false);
+    cell->nextRetired = NULL;
+    for (int i = 0; i < level; i++) {
+        new (&cell->next()[i]) atomic<uintptr_t>(0);
+    }
+    return cell;
+}
+
+/*
+ * Free a cell and, if it holds one, its value.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::destroyCell(Cell* cell, bool hasValue) {
+    if (hasValue) {
+        cell->value().~ValueType();
+    }
+    ::operator delete(cell);
+}
+
+/*
+ * Find the place for a value on every level, starting from the top. On
+ *   each level the search moves forward past cells that come before the
+ *   value and past deleted cells, which on level 0 means following every
+ *   marked link so that the value goes after the whole deleted prefix.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+typename LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::Cell*
+LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::locatePreds(const ValueType& value, Cell** preds, Cell** succs) {
+    Cell* deleted = NULL;
+    Cell* pred = head;
+    for (int i = MAX_LEVEL - 1; i >= 0; i--) {
+        uintptr_t link = pred->next()[i].load();
+        bool isDeleted = isMarked(link);
+        Cell* cur = unmarked(link);
+        while (cur != tail && (isMarked(cur->next()[0].load()) || (i == 0 && isDeleted) ||
+                               isBefore(cur, value))) {
+            if (isDeleted && i == 0) deleted = cur;
+            pred = cur;
+            link = pred->next()[i].load();
+            isDeleted = isMarked(link);
+            cur = unmarked(link);
+        }
+        preds[i] = pred;
+        succs[i] = cur;
+    }
+    return deleted;
+}
+
+/*
+ * Move each of the head's higher links forward past the cells that are
+ *   followed by a deleted cell, and so are deleted themselves.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::restructure() {
+    Cell* pred = head;
+    int i = MAX_LEVEL - 1;
+    while (i > 0) {
+        uintptr_t first = head->next()[i].load();
+        Cell* firstCell = unmarked(first);
+        if (firstCell == tail || !isMarked(firstCell->next()[0].load())) {
+            i--;
+            continue;
+        }
+        Cell* cur = unmarked(pred->next()[i].load());
+        while (cur != tail && isMarked(cur->next()[0].load())) {
+            pred = cur;
+            cur = unmarked(pred->next()[i].load());
+        }
+        if (head->next()[i].compare_exchange_strong(first, pred->next()[i].load())) {
+            i--;
+        }
+    }
+}
+
+/*
+ * Push a chain of cells onto the retired list of the current epoch. The
+ *   epoch is read after the cells were cut off, so every operation that
+ *   may still see them announced this epoch or an earlier one. Retiring
+ *   is also the moment to try to move the epoch on.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::retire(Cell* first, Cell* last) {
+    atomic<Cell*>& list = retired[globalEpoch.load() % 3];
+    Cell* oldRetired = list.load();
+    do {
+        last->nextRetired = oldRetired;
+    } while (!list.compare_exchange_weak(oldRetired, first));
+    tryAdvanceEpoch();
+}
+
+/*
+ * Claim a slot, starting from the one the thread used last, and announce
+ *   the current epoch in it. If the epoch moves on before the announcement
+ *   is seen, the new epoch is announced instead, so that the slot never
+ *   holds an epoch that had already ended when the operation began.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::beginOperation() {
+    static thread_local int lastSlot = int(hash<thread::id>()(this_thread::get_id()) % EPOCH_SLOTS);
+    int slot = lastSlot;
+    uint64_t epoch = globalEpoch.load();
+    while (true) {
+        uint64_t idle = IDLE;
+        if (epochSlots[slot].epoch.compare_exchange_strong(idle, epoch)) break;
+        slot = (slot + 1) % EPOCH_SLOTS;
+        epoch = globalEpoch.load();
+    }
+    while (true) {
+        uint64_t current = globalEpoch.load();
+        if (current == epoch) break;
+        epochSlots[slot].epoch.store(current);
+        epoch = current;
+    }
+    lastSlot = slot;
+    return slot;
+}
+
+/*
+ * Move the epoch on from e to e + 1 if no slot announces any other epoch.
+ *   Operations that announced e - 1 have then all finished, and none can
+ *   still see the cells retired in e - 1, so they are freed. The caller is
+ *   itself running in epoch e, which keeps the epoch from moving on again,
+ *   and the list from being reused, until it is done.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::tryAdvanceEpoch() {
+    uint64_t epoch = globalEpoch.load();
+    for (int i = 0; i < EPOCH_SLOTS; i++) {
+        uint64_t announced = epochSlots[i].epoch.load();
+        if (announced != IDLE && announced != epoch) return;
+    }
+    if (!globalEpoch.compare_exchange_strong(epoch, epoch + 1)) return;
+    destroyRetired(retired[(epoch - 1) % 3].exchange(NULL));
+}
+
+/*
+ * Free every cell in a chain of retired cells.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::destroyRetired(Cell* cell) {
+    while (cell != NULL) {
+        Cell* next = cell->nextRetired;
+        destroyCell(cell, true);
+        cell = next;
+    }
+}
+
+/*
+ * Return the stats kept so far.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+const Stats& LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::stats() {
+    return *this;
+}
+
+/*
+ * Walk the lowest level from the head to the tail, and then the retired
+ *   cells, adding up each cell with the links that follow it.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+MemoryUsage LockFreeSkipListPriorityQueue<ValueType, Compare, Stats>::memoryUsage() {
+    size_t totalBytes = sizeof(*this);
+    Cell* cell = head;
+    while (true) {
+        totalBytes += sizeof(Cell) + cell->level * sizeof(atomic<uintptr_t>);
+        if (cell == tail) break;
+        cell = unmarked(cell->next()[0].load());
+    }
+    for (int i = 0; i < 3; i++) {
+        for (cell = retired[i].load(); cell != NULL; cell = cell->nextRetired) {
+            totalBytes += sizeof(Cell) + cell->level * sizeof(atomic<uintptr_t>);
+        }
+    }
+    return MemoryUsage(numValues.load() * sizeof(ValueType), totalBytes);
+}
+
+#endif
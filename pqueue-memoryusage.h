@@ -0,0 +1,59 @@
+/**********************************************
+ * File: pqueue-memoryusage.h
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * The memory a priority queue takes, as reported by the memoryUsage()
+ *   function of every queue. The bytes are split into the payload, which
+ *   is the values themselves, and the overhead the queue needs to hold
+ *   them: the links and other fields of its cells, the capacity it has
+ *   allocated but not filled, its keys and locks, and the queue object
+ *   itself. Dividing either part by the size of the queue gives the bytes
+ *   it costs per value, which is what a queue has to be sized by when it
+ *   must fit a memory budget.
+ *
+ * The bytes counted are the ones the queue asks the allocator for. The
+ *   allocator's own headers and rounding are not included, and neither is
+ *   any memory that the values themselves point to, such as the characters
+ *   of a long string.
+ */
+#ifndef PQueue_MemoryUsage_Included
+#define PQueue_MemoryUsage_Included
+
+#include <cstddef>
+using namespace std;
+
+/* Type: MemoryUsage
+ * The bytes taken by a priority queue, split into payload and overhead.
+ */
+struct MemoryUsage {
+    /* Bytes taken by the values in the queue, sizeof(ValueType) each. */
+    size_t payloadBytes;
+
+    /* Every other byte taken by the queue, including the queue object. */
+    size_t overheadBytes;
+
+    /* Constructs a usage of no bytes at all. */
+    MemoryUsage() : payloadBytes(0), overheadBytes(0) {}
+
+    /* Constructs the usage of a queue that takes totalBytes in all, of
+     * which payloadBytes hold its values.
+     */
+    MemoryUsage(size_t payloadBytes, size_t totalBytes)
+        : payloadBytes(payloadBytes), overheadBytes(totalBytes - payloadBytes) {}
+
+    /* Returns the number of bytes taken in all. */
+    size_t totalBytes() const {
+        return payloadBytes + overheadBytes;
+    }
+
+    /* Adds the bytes of another usage to this one. */
+    MemoryUsage& operator+=(const MemoryUsage& other) {
+        payloadBytes += other.payloadBytes;
+        overheadBytes += other.overheadBytes;
+        return *this;
+    }
+};
+
+#endif
@@ -0,0 +1,427 @@
+/**********************************************
+ * File: pqueue-multiqueue.h
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * A relaxed priority queue for many threads, after the MultiQueue of
+ *   Rihani, Sanders and Dementiev ("MultiQueues: Simple Relaxed Concurrent
+ *   Priority Queues", 2015).
+ *
+ * A single heap, however it is locked, makes every thread fight over its
+ *   root. The MultiQueue instead keeps several ordinary HeapPriorityQueues,
+ *   usually two for every thread, each behind a lock of its own. An enqueue
+ *   adds its value to a randomly chosen heap, and a dequeue picks two heaps
+ *   at random and removes the smaller of their two smallest values. A
+ *   thread never waits for a lock: if a heap it picked is busy, it simply
+ *   picks again.
+ *
+ * The price is that a dequeue does not always return the smallest value
+ *   in the whole queue, only one that is close to it. The rank error, the
+ *   number of values in the queue that are smaller than the one returned,
+ *   is a small multiple of the number of heaps on average. With a single
+ *   heap the queue is exact.
+ */
+#ifndef PQueue_MultiQueue_Included
+#define PQueue_MultiQueue_Included
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <utility>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <random>
+#include "pqueue-heap.h"
+#include "error.h"
+#include "pqueue-stats.h"
+#include "pqueue-memoryusage.h"
+using namespace std;
+
+/* A class representing a relaxed priority queue made of several binary
+ * heaps. Values are ordered by Compare, which defaults to operator<, and
+ * must be default constructible.
+ *
+ * All operations may be called from several threads at once. The
+ * smallest values come out first only approximately; see above.
+ *
+ * Stats is a stats policy from pqueue-stats.h, which the heaps inside the
+ * queue use as well. The queue times its own operations, and stats()
+ * adds the counts of every heap to its own comparisons between heaps.
+ */
+template <typename ValueType, typename Compare = less<ValueType>, typename Stats = NoStats>
+class MultiQueuePriorityQueue : private Stats {
+public:
+	/* Constructs a new, empty priority queue made of numHeaps heaps. The
+	 * default is two heaps for every core of the machine.
+	 */
+	explicit MultiQueuePriorityQueue(int numHeaps = 2 * max(1, int(thread::hardware_concurrency())),
+	                                 Compare compare = Compare());
+
+	/* Returns the number of elements in the priority queue. */
+	int size();
+
+	/* Returns whether or not the priority queue is empty. */
+	bool isEmpty();
+
+	/* Returns the number of heaps the priority queue is made of. */
+	int numHeaps();
+
+	/* Enqueues a copy of a value into the priority queue. */
+	void enqueue(const ValueType& value);
+
+	/* Enqueues a value into the priority queue, moving it into storage. */
+	void enqueue(ValueType&& value);
+
+	/* Enqueues a value constructed from the given arguments. */
+	template <typename... Args>
+	void emplace(Args&&... args);
+
+	/* Returns a copy of the smallest value in the priority queue, looking
+	 * at every heap. A dequeueMin() right after it may still return a
+	 * different value.
+	 */
+	ValueType peek();
+
+	/* Returns and removes one of the smallest values in the priority queue. */
+	ValueType dequeueMin();
+
+	/* Removes one of the smallest values in the priority queue and moves it
+	 * into result. Returns false, leaving result alone, if the queue is
+	 * empty.
+	 */
+	bool tryDequeueMin(ValueType& result);
+
+	/* Removes k values from the priority queue, one dequeueMin() at a time,
+	 * and writes them to out in the order they were removed. Returns the
+	 * output iterator one past the last value written.
+	 */
+	template <typename OutputIterator>
+	OutputIterator dequeueMin(int k, OutputIterator out);
+
+	/* Removes every value from the priority queue. */
+	void clear();
+
+	/* Moves every value of other into this priority queue, leaving other
+	 * empty. Each heap of other is merged into one heap of this queue.
+	 */
+	void merge(MultiQueuePriorityQueue& other);
+
+	/* Returns a snapshot of the stats kept so far by the queue and all of
+	 * its heaps.
+	 */
+	Stats stats();
+
+	/* Returns the bytes the queue and all of its heaps take, split into the
+	 * values and the overhead. The heaps are locked one at a time, so the
+	 * result is only exact if no other thread is changing the queue.
+	 */
+	MemoryUsage memoryUsage();
+
+private:
+	// type of the heaps inside the queue
+	typedef HeapPriorityQueue<ValueType, Compare, 2, false, Stats> Heap;
+
+	// one of the heaps with its lock; the padding keeps the locks of
+	//   neighbouring heaps off each other's cache lines
+	struct Shard {
+		mutex lock;
+		Heap heap;
+		char padding[64];
+
+		explicit Shard(Compare compare) : heap(compare) {}
+	};
+	vector<unique_ptr<Shard> > shards;
+
+	// number of values in all heaps together
+	atomic<int> numValues;
+
+	// comparator deciding which of two values comes first
+	Compare isLess;
+
+	// compare two values, counting the comparison
+	bool lessThan(const ValueType& a, const ValueType& b);
+
+	// get a random heap number for the calling thread
+	int randomShard();
+
+	// remove a value from any heap that has one, waiting for locks; used
+	//   when the two heaps picked at random are both empty
+	bool dequeueFromAnyShard(ValueType& result);
+
+	// disallow copying, since the heaps hold locks
+	MultiQueuePriorityQueue(const MultiQueuePriorityQueue&);
+	MultiQueuePriorityQueue& operator=(const MultiQueuePriorityQueue&);
+};
+
+/*************************************************************
+ * Implementation of the MultiQueuePriorityQueue class. Since the class is
+ * a template, the implementation has to be visible in the header.
+ */
+
+/*
+ * Constructor to create the heaps.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+MultiQueuePriorityQueue<ValueType, Compare, Stats>::MultiQueuePriorityQueue(int numHeaps, Compare compare)
+    : numValues(0), isLess(compare) {
+    if (numHeaps < 1) error("A MultiQueue needs at least one heap");
+    for (int i = 0; i < numHeaps; i++) {
+        shards.push_back(unique_ptr<Shard>(new Shard(compare)));
+    }
+}
+
+/*
+ * Return the current size of the queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int MultiQueuePriorityQueue<ValueType, Compare, Stats>::size() {
+    return numValues.load();
+}
+
+/*
+ * Return whether the queue is empty.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool MultiQueuePriorityQueue<ValueType, Compare, Stats>::isEmpty() {
+    return (size() == 0);
+}
+
+/*
+ * Return the number of heaps.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int MultiQueuePriorityQueue<ValueType, Compare, Stats>::numHeaps() {
+    return shards.size();
+}
+
+/*
+ * Add a copy of a value to the queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void MultiQueuePriorityQueue<ValueType, Compare, Stats>::enqueue(const ValueType& value) {
+    emplace(value);
+}
+
+/*
+ * Add a value to the queue without copying it.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void MultiQueuePriorityQueue<ValueType, Compare, Stats>::enqueue(ValueType&& value) {
+    emplace(std::move(value));
+}
+
+/*
+ * Add a value to a random heap, picking another one whenever the chosen
+ *   heap is locked by another thread.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename... Args>
+void MultiQueuePriorityQueue<ValueType, Compare, Stats>::emplace(Args&&... args) {
+    typename Stats::Timer timer(*this, STATS_ENQUEUE);
+    while (true) {
+        Shard& shard = *shards[randomShard()];
+        if (shard.lock.try_lock()) {
+            try {
+                shard.heap.emplace(std::forward<Args>(args)...);
+            } catch (...) {
+                shard.lock.unlock();
+                throw;
+            }
+            shard.lock.unlock();
+            numValues++;
+            return;
+        }
+    }
+}
+
+/*
+ * Look at the smallest value of every heap.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+ValueType MultiQueuePriorityQueue<ValueType, Compare, Stats>::peek() {
+    bool found = false;
+    ValueType smallest = ValueType();
+    for (size_t i = 0; i < shards.size(); i++) {
+        lock_guard<mutex> guard(shards[i]->lock);
+        Heap& heap = shards[i]->heap;
+        if (!heap.isEmpty() && (!found || lessThan(heap.peek(), smallest))) {
+            smallest = heap.peek();
+            found = true;
+        }
+    }
+    if (!found) error("The queue is empty");
+    return smallest;
+}
+
+/*
+ * Remove and return one of the smallest values in the queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+ValueType MultiQueuePriorityQueue<ValueType, Compare, Stats>::dequeueMin() {
+    ValueType result;
+    if (!tryDequeueMin(result)) error("The queue is empty");
+    return result;
+}
+
+/*
+ * Pick two heaps at random and lock both without waiting, starting over
+ *   with two new heaps if either is busy. The smaller of their smallest
+ *   values is removed. If both heaps are empty but the queue is not, the
+ *   values are in other heaps, and the heaps are searched one by one.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool MultiQueuePriorityQueue<ValueType, Compare, Stats>::tryDequeueMin(ValueType& result) {
+    typename Stats::Timer timer(*this, STATS_DEQUEUE);
+    if (shards.size() == 1) return dequeueFromAnyShard(result);
+
+    while (true) {
+        if (numValues.load() == 0) return false;
+
+        int first = randomShard();
+        int second = randomShard();
+        if (first == second) continue;
+        Shard& firstShard = *shards[first];
+        Shard& secondShard = *shards[second];
+        if (!firstShard.lock.try_lock()) continue;
+        if (!secondShard.lock.try_lock()) {
+            firstShard.lock.unlock();
+            continue;
+        }
+
+        Heap* best = &firstShard.heap;
+        if (best->isEmpty() || (!secondShard.heap.isEmpty() &&
+                                lessThan(secondShard.heap.peek(), best->peek()))) {
+            best = &secondShard.heap;
+        }
+        bool found = !best->isEmpty();
+        if (found) {
+            result = best->dequeueMin();
+            numValues--;
+        }
+        secondShard.lock.unlock();
+        firstShard.lock.unlock();
+
+        if (found) return true;
+        return dequeueFromAnyShard(result);
+    }
+}
+
+/*
+ * Remove the k smallest elements from the queue one at a time.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename OutputIterator>
+OutputIterator MultiQueuePriorityQueue<ValueType, Compare, Stats>::dequeueMin(int k, OutputIterator out) {
+    if (k < 0 || k > size()) error("Cannot dequeue more values than the queue holds");
+
+    for (int i = 0; i < k; i++) {
+        *out++ = dequeueMin();
+    }
+    return out;
+}
+
+/*
+ * Remove every element from every heap.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void MultiQueuePriorityQueue<ValueType, Compare, Stats>::clear() {
+    for (size_t i = 0; i < shards.size(); i++) {
+        lock_guard<mutex> guard(shards[i]->lock);
+        numValues -= shards[i]->heap.size();
+        shards[i]->heap.clear();
+    }
+}
+
+/*
+ * Merge another queue into this one heap by heap. Both locks are taken
+ *   with std::lock, so two threads merging two queues into each other
+ *   cannot deadlock.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void MultiQueuePriorityQueue<ValueType, Compare, Stats>::merge(MultiQueuePriorityQueue& other) {
+    if (&other == this) return;
+    for (size_t i = 0; i < other.shards.size(); i++) {
+        Shard& target = *shards[i % shards.size()];
+        Shard& source = *other.shards[i];
+        std::lock(target.lock, source.lock);
+        lock_guard<mutex> targetGuard(target.lock, adopt_lock);
+        lock_guard<mutex> sourceGuard(source.lock, adopt_lock);
+        int moved = source.heap.size();
+        target.heap.merge(source.heap);
+        other.numValues -= moved;
+        numValues += moved;
+    }
+}
+
+/*
+ * Get a random heap number. Every thread has its own generator, so that
+ *   threads do not contend for it.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int MultiQueuePriorityQueue<ValueType, Compare, Stats>::randomShard() {
+    static thread_local minstd_rand random(hash<thread::id>()(this_thread::get_id()));
+    return random() % shards.size();
+}
+
+/*
+ * Search the heaps one by one for a value. Since the heaps are visited in
+ *   turn, the value found is not necessarily among the smallest.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool MultiQueuePriorityQueue<ValueType, Compare, Stats>::dequeueFromAnyShard(ValueType& result) {
+    int start = randomShard();
+    for (size_t i = 0; i < shards.size(); i++) {
+        Shard& shard = *shards[(start + i) % shards.size()];
+        lock_guard<mutex> guard(shard.lock);
+        if (!shard.heap.isEmpty()) {
+            result = shard.heap.dequeueMin();
+            numValues--;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Copy the queue's own stats and add the counts of each heap. The counts
+ *   are atomic, so the heaps do not have to be locked, but a thread that
+ *   is running at the same time may be counted in some heaps and not yet
+ *   in others.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+Stats MultiQueuePriorityQueue<ValueType, Compare, Stats>::stats() {
+    Stats total(*this);
+    for (size_t i = 0; i < shards.size(); i++) {
+        total.addCounts(shards[i]->heap.stats());
+    }
+    return total;
+}
+
+/*
+ * Add up the heaps, each under its lock, and the shards around them.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+MemoryUsage MultiQueuePriorityQueue<ValueType, Compare, Stats>::memoryUsage() {
+    MemoryUsage total(0, sizeof(*this) + shards.capacity() * sizeof(unique_ptr<Shard>));
+    for (size_t i = 0; i < shards.size(); i++) {
+        lock_guard<mutex> guard(shards[i]->lock);
+        total += shards[i]->heap.memoryUsage();
+        total.overheadBytes += sizeof(Shard) - sizeof(Heap);
+    }
+    return total;
+}
+
+/*
+ * Compare two values with the comparator, counting the comparison in the
+ *   stats.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool MultiQueuePriorityQueue<ValueType, Compare, Stats>::lessThan(const ValueType& a, const ValueType& b) {
+    Stats::countComparison();
+    return isLess(a, b);
+}
+
+#endif
@@ -0,0 +1,253 @@
+/**********************************************
+ * File: pqueue-nodepool.h
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * A pool that hands out memory for the cells of the node-based priority
+ *   queues. Calling new and delete for every cell makes the allocator the
+ *   most expensive part of an enqueue or dequeue, and scatters the cells
+ *   across memory. The pool instead carves cells out of large slabs and
+ *   keeps the cells that have been given back on a free list, so that they
+ *   can be handed out again without going back to the allocator. All slabs
+ *   are released together when the pool is destroyed.
+ */
+#ifndef PQueue_NodePool_Included
+#define PQueue_NodePool_Included
+
+#include <vector>
+#include <new>
+#include <utility>
+#include <type_traits>
+using namespace std;
+
+/*
+ * A pool of memory for nodes of type NodeType. Each queue has a pool of
+ *   its own, but several queues may share one as long as the pool outlives
+ *   all of them. A pool is not safe to use from several threads at once.
+ */
+template <typename NodeType>
+class NodePool {
+public:
+    /* Constructs an empty pool; no memory is allocated until it is needed. */
+    NodePool();
+
+    /* Releases every slab. Any nodes still handed out become invalid, but
+     * their destructors are not run.
+     */
+    ~NodePool();
+
+    /* Constructs a node in memory taken from the pool. */
+    template <typename... Args>
+    NodeType* create(Args&&... args);
+
+    /* Destroys a node and gives its memory back to the pool. */
+    void destroy(NodeType* node);
+
+    /* Takes over all the memory of another pool, which is left empty.
+     * Nodes created by the other pool may then be destroyed through this
+     * one, and are released with this pool.
+     */
+    void absorb(NodePool& other);
+
+    /* Returns the number of bytes the pool has taken from the allocator,
+     * whether or not they are handed out at the moment.
+     */
+    size_t allocatedBytes() const;
+
+    /* Returns the number of bytes each node takes in the pool. */
+    static size_t nodeBytes();
+
+    /* Returns the bytes to charge to a queue that holds numNodes nodes from
+     * this pool: all the memory the pool has taken if the queue owns it,
+     * or only the share its own nodes take if the pool is shared. The pool
+     * object itself is part of the queue that holds it, whether or not
+     * that queue uses it, and is not counted here.
+     */
+    size_t bytesFor(size_t numNodes, bool ownsPool) const;
+
+private:
+    // a slot in a slab holds either a node or, while it is free, a pointer
+    //   to the next free slot
+    union Slot {
+        Slot* nextFree;
+        typename aligned_storage<sizeof(NodeType), alignof(NodeType)>::type node;
+    };
+
+    // slabs allocated so far, released by the destructor, and the number
+    //   of slots in all of them together
+    vector<Slot*> slabs;
+    size_t numSlots;
+
+    // slots that have been given back and can be handed out again
+    Slot* freeList;
+
+    // slots in the newest slab that have never been handed out
+    Slot* nextUnused;
+    Slot* slabEnd;
+
+    // number of slots in the next slab to be allocated; slabs start small
+    //   so that a small queue wastes little, and double up to a limit
+    int nextSlabSize;
+    static const int INITIAL_SLAB_SIZE = 32;
+    static const int MAX_SLAB_SIZE = 4096;
+
+    // allocate a new slab of slots
+    void allocateSlab();
+
+    // a pool owns its slabs, so it cannot be copied
+    NodePool(const NodePool&);
+    NodePool& operator=(const NodePool&);
+};
+
+/*
+ * Get a queue whose cells come from pool ready to take over the cells of
+ *   another queue, whose cells come from otherPool. This works if the two
+ *   queues share a pool, or if the other queue owns its pool, in which case
+ *   its memory is absorbed into pool. If the other queue shares its pool
+ *   with further queues, that memory cannot be taken over and false is
+ *   returned; the values then have to be moved into new cells instead.
+ */
+template <typename NodeType>
+bool takeOverCells(NodePool<NodeType>* pool, NodePool<NodeType>* otherPool, bool otherOwnsPool) {
+    if (pool == otherPool) return true;
+    if (!otherOwnsPool) return false;
+    pool->absorb(*otherPool);
+    return true;
+}
+
+/*************************************************************
+ * Implementation of the NodePool class. Since the class is a template,
+ * the implementation has to be visible in the header.
+ */
+
+/*
+ * Constructor to start the pool without any slabs.
+ */
+template <typename NodeType>
+NodePool<NodeType>::NodePool() {
+    freeList = NULL;
+    nextUnused = NULL;
+    slabEnd = NULL;
+    numSlots = 0;
+    nextSlabSize = INITIAL_SLAB_SIZE;
+}
+
+/*
+ * Destructor to release all slabs at once.
+ */
+template <typename NodeType>
+NodePool<NodeType>::~NodePool() {
+    for (size_t i = 0; i < slabs.size(); i++) {
+        ::operator delete(slabs[i]);
+    }
+}
+
+/*
+ * Construct a node, preferring a slot that was given back over a fresh one.
+ */
+template <typename NodeType>
+template <typename... Args>
+NodeType* NodePool<NodeType>::create(Args&&... args) {
+    Slot* slot;
+    if (freeList != NULL) {
+        slot = freeList;
+        freeList = freeList->nextFree;
+    } else {
+        if (nextUnused == slabEnd) {
+            allocateSlab();
+        }
+        slot = nextUnused++;
+    }
+
+    // if the constructor throws, the slot goes back on the free list
+    try {
+        return new (&slot->node) NodeType(std::forward<Args>(args)...);
+    } catch (...) {
+        slot->nextFree = freeList;
+        freeList = slot;
+        throw;
+    }
+}
+
+/*
+ * Destroy a node and put its slot on the free list.
+ */
+template <typename NodeType>
+void NodePool<NodeType>::destroy(NodeType* node) {
+    node->~NodeType();
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->nextFree = freeList;
+    freeList = slot;
+}
+
+/*
+ * Take over the slabs of another pool. Its free slots and the slots it
+ *   has not handed out yet join this pool's free list.
+ */
+template <typename NodeType>
+void NodePool<NodeType>::absorb(NodePool& other) {
+    if (&other == this) return;
+    slabs.insert(slabs.end(), other.slabs.begin(), other.slabs.end());
+    while (other.freeList != NULL) {
+        Slot* slot = other.freeList;
+        other.freeList = slot->nextFree;
+        slot->nextFree = freeList;
+        freeList = slot;
+    }
+    for (Slot* slot = other.nextUnused; slot != other.slabEnd; slot++) {
+        slot->nextFree = freeList;
+        freeList = slot;
+    }
+    numSlots += other.numSlots;
+    other.slabs.clear();
+    other.numSlots = 0;
+    other.nextUnused = NULL;
+    other.slabEnd = NULL;
+}
+
+/*
+ * Count the slabs and the array that keeps track of them.
+ */
+template <typename NodeType>
+size_t NodePool<NodeType>::allocatedBytes() const {
+    return numSlots * sizeof(Slot) + slabs.capacity() * sizeof(Slot*);
+}
+
+/*
+ * A node takes a whole slot, which may be larger than the node itself.
+ */
+template <typename NodeType>
+size_t NodePool<NodeType>::nodeBytes() {
+    return sizeof(Slot);
+}
+
+/*
+ * Charge the whole pool to its owner, and each sharer for its nodes.
+ */
+template <typename NodeType>
+size_t NodePool<NodeType>::bytesFor(size_t numNodes, bool ownsPool) const {
+    return ownsPool ? allocatedBytes() : numNodes * nodeBytes();
+}
+
+/*
+ * Allocate the next slab and make its slots available.
+ */
+template <typename NodeType>
+void NodePool<NodeType>::allocateSlab() {
+    Slot* slab = static_cast<Slot*>(::operator new(nextSlabSize * sizeof(Slot)));
+    try {
+        slabs.push_back(slab);
+    } catch (...) {
+        ::operator delete(slab);
+        throw;
+    }
+    numSlots += nextSlabSize;
+    nextUnused = slab;
+    slabEnd = slab + nextSlabSize;
+    if (nextSlabSize < MAX_SLAB_SIZE) {
+        nextSlabSize *= 2;
+    }
+}
+
+#endif
@@ -0,0 +1,234 @@
+/**********************************************
+ * File: pqueue-packedkeys.h
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * Packed keys let the VectorPriorityQueue find its smallest value by
+ *   comparing plain 64-bit integers instead of calling the comparator on
+ *   every value. Each value is summarized by a key whose order agrees with
+ *   the order of the values: if the key of a is smaller than the key of b,
+ *   then a must come before b. Values whose keys are equal are still
+ *   ordered by the comparator, so a key only has to be a prefix of the
+ *   full ordering, such as the first eight characters of a string.
+ *
+ * A key traits class has a constant IS_PACKED and a static function key()
+ *   that maps a value to an unsigned 64-bit key. The queue uses NoPackedKeys
+ *   unless it is told otherwise, and the traits must agree with the
+ *   comparator the queue was given.
+ */
+#ifndef PQueue_PackedKeys_Included
+#define PQueue_PackedKeys_Included
+
+#include <string>
+#include <cstdint>
+#include <type_traits>
+// the vector kernels below are compiled for their instruction sets on their
+//   own, so they exist in every x86 build and are chosen when the program runs
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define PQUEUE_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+using namespace std;
+
+/* Key traits for a queue that compares its values directly. */
+struct NoPackedKeys {
+    static const bool IS_PACKED = false;
+
+    template <typename ValueType>
+    static uint64_t key(const ValueType&) {
+        return 0;
+    }
+};
+
+/* Key traits for strings ordered by operator<. The key holds the first
+ * eight characters, so strings that share them are told apart by the
+ * comparator.
+ */
+struct StringPrefixKey {
+    static const bool IS_PACKED = true;
+
+    static uint64_t key(const string& value) {
+        uint64_t key = 0;
+        for (size_t i = 0; i < 8; i++) {
+            key <<= 8;
+            if (i < value.size()) key |= (unsigned char) value[i];
+        }
+        return key;
+    }
+};
+
+/* Key traits for integers ordered by operator<. The key is exact. */
+template <typename IntegerType>
+struct IntegerKey {
+    static_assert(is_integral<IntegerType>::value && sizeof(IntegerType) <= 8,
+                  "IntegerKey needs an integer type of at most 64 bits");
+    static const bool IS_PACKED = true;
+
+    static uint64_t key(IntegerType value) {
+        // flip the sign bit so that negative values sort below the others
+        if (is_signed<IntegerType>::value) {
+            return uint64_t(int64_t(value)) ^ (uint64_t(1) << 63);
+        }
+        return uint64_t(value);
+    }
+};
+
+/* Key traits for values ordered the opposite way from KeyTraits, such as
+ * integers ordered by greater<int>.
+ */
+template <typename KeyTraits>
+struct ReverseKey {
+    static const bool IS_PACKED = KeyTraits::IS_PACKED;
+
+    template <typename ValueType>
+    static uint64_t key(const ValueType& value) {
+        return ~KeyTraits::key(value);
+    }
+};
+
+/*
+ * Convert an unsigned key into a signed one with the same order. The
+ *   vector instructions below can only compare signed 64-bit integers.
+ */
+inline int64_t toSignedKey(uint64_t key) {
+    return int64_t(key ^ (uint64_t(1) << 63));
+}
+
+/* The ways packedArgmin() can compare the keys: one at a time, or two or
+ * four at a time with the SSE4.2 or AVX2 instructions.
+ */
+enum ArgminKernel { ARGMIN_SCALAR, ARGMIN_SSE42, ARGMIN_AVX2 };
+
+/*
+ * Return the name of a kernel, for reports.
+ */
+inline const char* argminKernelName(ArgminKernel kernel) {
+    switch (kernel) {
+    case ARGMIN_AVX2: return "avx2";
+    case ARGMIN_SSE42: return "sse4.2";
+    default: return "scalar";
+    }
+}
+
+/*
+ * Check whether the processor the program runs on has the instructions a
+ *   kernel needs.
+ */
+inline bool isArgminKernelSupported(ArgminKernel kernel) {
+#if defined(PQUEUE_X86_KERNELS)
+    if (kernel == ARGMIN_AVX2) return __builtin_cpu_supports("avx2");
+    if (kernel == ARGMIN_SSE42) return __builtin_cpu_supports("sse4.2");
+#endif
+    return kernel == ARGMIN_SCALAR;
+}
+
+/*
+ * Return the kernel packedArgmin() uses, which starts out as the fastest
+ *   one the processor supports.
+ */
+inline ArgminKernel& activeArgminKernel() {
+    static ArgminKernel kernel = isArgminKernelSupported(ARGMIN_AVX2) ? ARGMIN_AVX2 :
+                                 isArgminKernelSupported(ARGMIN_SSE42) ? ARGMIN_SSE42 : ARGMIN_SCALAR;
+    return kernel;
+}
+
+/*
+ * Make packedArgmin() use a given kernel, so that each one can be tested
+ *   and timed. Returns false, leaving the kernel alone, if the processor
+ *   does not support it.
+ */
+inline bool setArgminKernel(ArgminKernel kernel) {
+    if (!isArgminKernelSupported(kernel)) return false;
+    activeArgminKernel() = kernel;
+    return true;
+}
+
+/*
+ * Finish a search for the first smallest key by comparing keys[i..n) one
+ *   by one against keys[best].
+ */
+inline int scalarArgmin(const int64_t* keys, int n, int best, int i) {
+    for (; i < n; i++) {
+        if (keys[i] < keys[best]) best = i;
+    }
+    return best;
+}
+
+#if defined(PQUEUE_X86_KERNELS)
+/*
+ * Find the first smallest key four at a time. Each lane keeps the smallest
+ *   key it has seen and where it was, and the lanes are combined at the end.
+ */
+__attribute__((target("avx2")))
+inline int avx2Argmin(const int64_t* keys, int n) {
+    if (n < 8) return scalarArgmin(keys, n, 0, 1);
+    __m256i minKeys = _mm256_loadu_si256((const __m256i*) keys);
+    __m256i minIndices = _mm256_setr_epi64x(0, 1, 2, 3);
+    __m256i indices = minIndices;
+    const __m256i step = _mm256_set1_epi64x(4);
+    int i;
+    for (i = 4; i + 4 <= n; i += 4) {
+        indices = _mm256_add_epi64(indices, step);
+        __m256i next = _mm256_loadu_si256((const __m256i*) (keys + i));
+        __m256i isSmaller = _mm256_cmpgt_epi64(minKeys, next);
+        minKeys = _mm256_blendv_epi8(minKeys, next, isSmaller);
+        minIndices = _mm256_blendv_epi8(minIndices, indices, isSmaller);
+    }
+    int64_t laneIndices[4];
+    _mm256_storeu_si256((__m256i*) laneIndices, minIndices);
+    int best = int(laneIndices[0]);
+    for (int lane = 1; lane < 4; lane++) {
+        int index = int(laneIndices[lane]);
+        if (keys[index] < keys[best] || (keys[index] == keys[best] && index < best)) {
+            best = index;
+        }
+    }
+    return scalarArgmin(keys, n, best, i);
+}
+
+/*
+ * Find the first smallest key two at a time, the same way.
+ */
+__attribute__((target("sse4.2")))
+inline int sse42Argmin(const int64_t* keys, int n) {
+    if (n < 4) return scalarArgmin(keys, n, 0, 1);
+    __m128i minKeys = _mm_loadu_si128((const __m128i*) keys);
+    __m128i minIndices = _mm_set_epi64x(1, 0);
+    __m128i indices = minIndices;
+    const __m128i step = _mm_set1_epi64x(2);
+    int i;
+    for (i = 2; i + 2 <= n; i += 2) {
+        indices = _mm_add_epi64(indices, step);
+        __m128i next = _mm_loadu_si128((const __m128i*) (keys + i));
+        __m128i isSmaller = _mm_cmpgt_epi64(minKeys, next);
+        minKeys = _mm_blendv_epi8(minKeys, next, isSmaller);
+        minIndices = _mm_blendv_epi8(minIndices, indices, isSmaller);
+    }
+    int64_t laneIndices[2];
+    _mm_storeu_si128((__m128i*) laneIndices, minIndices);
+    int best = int(laneIndices[0]);
+    int index = int(laneIndices[1]);
+    if (keys[index] < keys[best] || (keys[index] == keys[best] && index < best)) {
+        best = index;
+    }
+    return scalarArgmin(keys, n, best, i);
+}
+#endif
+
+/*
+ * Return the index of the first smallest key in keys[0..n), where n is at
+ *   least 1, with the active kernel.
+ */
+inline int packedArgmin(const int64_t* keys, int n) {
+#if defined(PQUEUE_X86_KERNELS)
+    switch (activeArgminKernel()) {
+    case ARGMIN_AVX2: return avx2Argmin(keys, n);
+    case ARGMIN_SSE42: return sse42Argmin(keys, n);
+    default: break;
+    }
+#endif
+    return scalarArgmin(keys, n, 0, 1);
+}
+
+#endif
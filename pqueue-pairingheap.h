@@ -0,0 +1,511 @@
+/**********************************************
+ * File: pqueue-pairingheap.h
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * A priority queue class backed by a pairing heap.
+ *
+ * A pairing heap is a single tree in which every cell is no larger than
+ *   its children, and a cell may have any number of children. The children
+ *   of a cell are kept in a doubly-linked list, with the leftmost child
+ *   linked back to its parent.
+ * The basic step is linking two trees: the root with the larger value
+ *   becomes the leftmost child of the other root. An enqueue links a new
+ *   one-cell tree with the heap, and a decreaseKey() cuts the cell's
+ *   subtree out and links it with the heap, both in O(1) time.
+ * A dequeueMin() removes the root, which leaves a list of subtrees. These
+ *   are joined back into one tree in two passes: first neighbouring
+ *   subtrees are linked in pairs from left to right, then the pairs are
+ *   linked into one tree from right to left. This runs in O(log n)
+ *   amortized time.
+ *
+ * The pairing heap offers the same operations as the Fibonacci heap, but
+ *   its cells are smaller and it does no consolidation bookkeeping, so it
+ *   is usually faster in practice.
+ */
+#ifndef PQueue_PairingHeap_Included
+#define PQueue_PairingHeap_Included
+
+#include <string>
+#include <functional>
+#include <utility>
+#include "pqueue-nodepool.h"
+#include "error.h"
+#include "pqueue-stats.h"
+#include "pqueue-memoryusage.h"
+using namespace std;
+
+/*
+ * A cell of a pairing heap.
+ */
+template <typename ValueType>
+struct PCell {
+    // value stored in this cell
+    ValueType value;
+
+    // leftmost child of this cell
+    PCell* child = NULL;
+
+    // next sibling to the right
+    PCell* next = NULL;
+
+    // previous sibling to the left, or the parent for the leftmost child;
+    //   NULL for the root
+    PCell* previous = NULL;
+
+    // construct the value in place from the given arguments
+    template <typename... Args>
+    explicit PCell(Args&&... args) : value(std::forward<Args>(args)...) {}
+};
+
+/*
+ * Pairing heap implementation of the priority queue. Values are ordered
+ *   by Compare, which defaults to operator<. Under CountingStats every
+ *   link of two trees is counted, and so is every pass of
+ *   combineSiblings(), which plays the part of the Fibonacci heap's
+ *   consolidate.
+ */
+template <typename ValueType, typename Compare = less<ValueType>, typename Stats = NoStats>
+class PairingHeapPriorityQueue : private Stats {
+  public:
+	/* Constructs a new, empty priority queue ordered by the given comparator. */
+	explicit PairingHeapPriorityQueue(Compare compare = Compare());
+
+	/* The pool that the cells of this kind of queue are allocated from. */
+	typedef NodePool<PCell<ValueType> > Pool;
+
+	/* Constructs a new, empty priority queue that allocates its cells from
+	 * a pool shared with other queues. The pool must outlive the queue.
+	 */
+	explicit PairingHeapPriorityQueue(Pool& sharedPool, Compare compare = Compare());
+
+	/* Cleans up all memory allocated by this priority queue. */
+	~PairingHeapPriorityQueue();
+
+	/* Returns the number of elements in the priority queue. */
+	int size();
+
+	/* Returns whether or not the priority queue is empty. */
+	bool isEmpty();
+
+	/* A handle to a value stored in the queue. A handle stays valid until
+	 * its value leaves the queue through dequeueMin(), remove() or clear().
+	 */
+	typedef PCell<ValueType>* Handle;
+
+	/* Enqueues a copy of a value into the priority queue and returns a
+	 * handle that can later be passed to decreaseKey() or remove().
+	 */
+	Handle enqueue(const ValueType& value);
+
+	/* Enqueues a value into the priority queue, moving it into storage. */
+	Handle enqueue(ValueType&& value);
+
+	/* Enqueues a value constructed in place from the given arguments. */
+	template <typename... Args>
+	Handle emplace(Args&&... args);
+
+	/* Lowers the value referred to by the handle to newValue, which must
+	 * not be larger than its current value. Runs in O(1) time.
+	 */
+	void decreaseKey(Handle handle, ValueType newValue);
+
+	/* Removes the value referred to by the handle from the queue. */
+	void remove(Handle handle);
+
+	/* Returns, but does not remove, the first value in the priority queue. */
+	const ValueType& peek();
+
+	/* Returns and removes the first value in the priority queue. */
+	ValueType dequeueMin();
+
+	/* Removes the k smallest values from the priority queue and writes them
+	 * to out in sorted order. Returns the output iterator one past the last
+	 * value written.
+	 */
+	template <typename OutputIterator>
+	OutputIterator dequeueMin(int k, OutputIterator out);
+
+	/* Removes every value from the priority queue. */
+	void clear();
+
+	/* Moves every value of other into this priority queue, leaving other
+	 * empty. The two trees are linked in O(1) time and no value is copied.
+	 * Handles into other then refer to this queue, unless other shares a
+	 * pool with further queues, in which case its values are moved into
+	 * new cells in linear time and its handles become invalid.
+	 */
+	void merge(PairingHeapPriorityQueue& other);
+
+	/* Returns the stats the queue has kept so far. */
+	const Stats& stats();
+
+	/* Returns the bytes the heap takes, split into the values and the
+	 * overhead of their cells. A heap that owns its pool counts all of it;
+	 * one that shares its pool counts only its own cells.
+	 */
+	MemoryUsage memoryUsage();
+
+  private:
+    // the root of the tree, which holds the smallest value
+    PCell<ValueType>* root;
+
+    // number of cells in the tree
+    int numCells;
+
+    // comparator deciding which of two values comes first
+    Compare isLess;
+
+    // compare two values, counting the comparison
+    bool lessThan(const ValueType& a, const ValueType& b);
+
+    // pool used when the queue is not given one to share, and the pool
+    //   that the cells actually come from
+    Pool ownPool;
+    Pool* pool;
+
+    // link two trees and return the root of the result
+    PCell<ValueType>* link(PCell<ValueType>* first, PCell<ValueType>* second);
+
+    // join a list of sibling trees into one tree with the two-pass method
+    PCell<ValueType>* combineSiblings(PCell<ValueType>* first);
+
+    // cut a cell and its subtree out of the tree
+    void detach(PCell<ValueType>* cell);
+
+    // take a tree apart, calling action on each cell once the walk no
+    //   longer needs it, so that action may destroy the cell
+    template <typename Action>
+    static void dismantle(PCell<ValueType>* root, Action action);
+
+    // the heap owns its cells, so it cannot be copied
+    PairingHeapPriorityQueue(const PairingHeapPriorityQueue&);
+    PairingHeapPriorityQueue& operator=(const PairingHeapPriorityQueue&);
+};
+
+/*************************************************************
+ * Implementation of the PairingHeapPriorityQueue class. Since the class
+ * is a template, the implementation has to be visible in the header.
+ */
+
+/*
+ * Constructor to start the heap empty.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+PairingHeapPriorityQueue<ValueType, Compare, Stats>::PairingHeapPriorityQueue(Compare compare)
+    : isLess(compare) {
+    root = NULL;
+    numCells = 0;
+    pool = &ownPool;
+}
+
+/*
+ * Constructor to start the heap empty, taking its cells from a shared pool.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+PairingHeapPriorityQueue<ValueType, Compare, Stats>::PairingHeapPriorityQueue(Pool& sharedPool,
+                                                                              Compare compare)
+    : isLess(compare) {
+    root = NULL;
+    numCells = 0;
+    pool = &sharedPool;
+}
+
+/*
+ * Destructor to free every cell.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+PairingHeapPriorityQueue<ValueType, Compare, Stats>::~PairingHeapPriorityQueue() {
+    clear();
+}
+
+/*
+ * Return the number of cells in the heap.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int PairingHeapPriorityQueue<ValueType, Compare, Stats>::size() {
+    return numCells;
+}
+
+/*
+ * Return whether the heap is empty.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool PairingHeapPriorityQueue<ValueType, Compare, Stats>::isEmpty() {
+    return (numCells == 0);
+}
+
+/*
+ * Add a copy of a value to the heap.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+typename PairingHeapPriorityQueue<ValueType, Compare, Stats>::Handle
+PairingHeapPriorityQueue<ValueType, Compare, Stats>::enqueue(const ValueType& value) {
+    return emplace(value);
+}
+
+/*
+ * Add a value to the heap, moving it into its cell.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+typename PairingHeapPriorityQueue<ValueType, Compare, Stats>::Handle
+PairingHeapPriorityQueue<ValueType, Compare, Stats>::enqueue(ValueType&& value) {
+    return emplace(std::move(value));
+}
+
+/*
+ * Add a new value by linking a one-cell tree holding it with the heap.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename... Args>
+typename PairingHeapPriorityQueue<ValueType, Compare, Stats>::Handle
+PairingHeapPriorityQueue<ValueType, Compare, Stats>::emplace(Args&&... args) {
+    typename Stats::Timer timer(*this, STATS_ENQUEUE);
+    PCell<ValueType>* newCell = pool->create(std::forward<Args>(args)...);
+    root = (root == NULL) ? newCell : link(root, newCell);
+    numCells++;
+    return newCell;
+}
+
+/*
+ * Lower the value stored in a cell. Its subtree is still in heap order, so
+ *   it is cut out and linked back in with the root.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void PairingHeapPriorityQueue<ValueType, Compare, Stats>::decreaseKey(Handle handle, ValueType newValue) {
+    if (lessThan(handle->value, newValue)) error("New value is larger than the current value");
+    handle->value = std::move(newValue);
+    if (handle != root) {
+        detach(handle);
+        root = link(root, handle);
+    }
+}
+
+/*
+ * Remove an arbitrary cell. Its subtree is cut out, the cell's children
+ *   are joined the same way dequeueMin() joins the root's, and the result
+ *   is linked back in with the root.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void PairingHeapPriorityQueue<ValueType, Compare, Stats>::remove(Handle handle) {
+    if (handle == root) {
+        dequeueMin();
+        return;
+    }
+    detach(handle);
+    PCell<ValueType>* children = combineSiblings(handle->child);
+    pool->destroy(handle);
+    if (children != NULL) {
+        root = link(root, children);
+    }
+    numCells--;
+}
+
+/*
+ * Return, but do not remove, the value at the root.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+const ValueType& PairingHeapPriorityQueue<ValueType, Compare, Stats>::peek() {
+    if (isEmpty()) error("Cannot peek at an empty heap");
+    return root->value;
+}
+
+/*
+ * Remove the root and join its children into the new tree.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+ValueType PairingHeapPriorityQueue<ValueType, Compare, Stats>::dequeueMin() {
+    typename Stats::Timer timer(*this, STATS_DEQUEUE);
+    if (isEmpty()) error("Cannot dequeue from an empty heap");
+    ValueType val = std::move(root->value);
+    PCell<ValueType>* children = root->child;
+    pool->destroy(root);
+    root = combineSiblings(children);
+    numCells--;
+    return val;
+}
+
+/*
+ * Remove the k smallest elements, extracting the root each time.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename OutputIterator>
+OutputIterator PairingHeapPriorityQueue<ValueType, Compare, Stats>::dequeueMin(int k, OutputIterator out) {
+    if (k < 0 || k > numCells) error("Cannot dequeue more values than the heap holds");
+    for (int i = 0; i < k; i++) {
+        *out++ = std::move(root->value);
+        PCell<ValueType>* children = root->child;
+        pool->destroy(root);
+        root = combineSiblings(children);
+        numCells--;
+    }
+    return out;
+}
+
+/*
+ * Remove every cell.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void PairingHeapPriorityQueue<ValueType, Compare, Stats>::clear() {
+    dismantle(root, [this](PCell<ValueType>* cell) {
+        pool->destroy(cell);
+    });
+    root = NULL;
+    numCells = 0;
+}
+
+/*
+ * Merge another heap into this one by linking the two trees.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void PairingHeapPriorityQueue<ValueType, Compare, Stats>::merge(PairingHeapPriorityQueue& other) {
+    if (&other == this || other.isEmpty()) return;
+
+    if (!takeOverCells(pool, other.pool, other.pool == &other.ownPool)) {
+        // the other cells belong to a pool this heap cannot take over, so
+        //   take the other tree apart, moving each value into a cell of
+        //   this heap's pool
+        dismantle(other.root, [this, &other](PCell<ValueType>* cell) {
+            emplace(std::move(cell->value));
+            other.pool->destroy(cell);
+        });
+    } else {
+        root = (root == NULL) ? other.root : link(root, other.root);
+        numCells += other.numCells;
+    }
+    other.root = NULL;
+    other.numCells = 0;
+}
+
+/*
+ * Walk a tree without a stack by flattening it into a single chain as it
+ *   goes: whenever a cell with children is reached, its list of children
+ *   is spliced into the chain right after it. The next cell is found
+ *   before action is called, so action may destroy the cell.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename Action>
+void PairingHeapPriorityQueue<ValueType, Compare, Stats>::dismantle(PCell<ValueType>* root, Action action) {
+    PCell<ValueType>* cell = root;
+    while (cell != NULL) {
+        if (cell->child != NULL) {
+            PCell<ValueType>* lastChild = cell->child;
+            while (lastChild->next != NULL) {
+                lastChild = lastChild->next;
+            }
+            lastChild->next = cell->next;
+            cell->next = cell->child;
+        }
+        PCell<ValueType>* next = cell->next;
+        action(cell);
+        cell = next;
+    }
+}
+
+/*
+ * Link two trees: the root with the larger value becomes the leftmost
+ *   child of the other. On a tie the first tree stays on top. Both cells
+ *   must be roots, with no siblings.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+PCell<ValueType>* PairingHeapPriorityQueue<ValueType, Compare, Stats>::link(PCell<ValueType>* first,
+                                                                            PCell<ValueType>* second) {
+    Stats::countLink();
+    if (lessThan(second->value, first->value)) {
+        swap(first, second);
+    }
+    second->previous = first;
+    second->next = first->child;
+    if (first->child != NULL) {
+        first->child->previous = second;
+    }
+    first->child = second;
+    return first;
+}
+
+/*
+ * Join a list of sibling trees into one. The first pass links the trees
+ *   in pairs from left to right, pushing each pair onto a stack threaded
+ *   through the next pointers. The second pass pops the pairs, so they are
+ *   linked into the result from right to left.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+PCell<ValueType>* PairingHeapPriorityQueue<ValueType, Compare, Stats>::combineSiblings(PCell<ValueType>* first) {
+    Stats::countConsolidation();
+    PCell<ValueType>* pairs = NULL;
+    while (first != NULL) {
+        PCell<ValueType>* tree = first;
+        PCell<ValueType>* partner = first->next;
+        first = (partner == NULL) ? NULL : partner->next;
+
+        tree->next = NULL;
+        tree->previous = NULL;
+        if (partner != NULL) {
+            partner->next = NULL;
+            partner->previous = NULL;
+            tree = link(tree, partner);
+        }
+        tree->next = pairs;
+        pairs = tree;
+    }
+
+    if (pairs == NULL) return NULL;
+    PCell<ValueType>* result = pairs;
+    pairs = pairs->next;
+    result->next = NULL;
+    while (pairs != NULL) {
+        PCell<ValueType>* tree = pairs;
+        pairs = pairs->next;
+        tree->next = NULL;
+        result = link(tree, result);
+    }
+    return result;
+}
+
+/*
+ * Unlink a cell from its siblings, or from its parent if it is the
+ *   leftmost child, leaving it the root of its own tree.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void PairingHeapPriorityQueue<ValueType, Compare, Stats>::detach(PCell<ValueType>* cell) {
+    if (cell->previous->child == cell) {
+        cell->previous->child = cell->next;
+    } else {
+        cell->previous->next = cell->next;
+    }
+    if (cell->next != NULL) {
+        cell->next->previous = cell->previous;
+    }
+    cell->next = NULL;
+    cell->previous = NULL;
+}
+
+/*
+ * Return the stats kept so far.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+const Stats& PairingHeapPriorityQueue<ValueType, Compare, Stats>::stats() {
+    return *this;
+}
+
+/*
+ * Count the cells, or the whole pool if the heap owns it.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+MemoryUsage PairingHeapPriorityQueue<ValueType, Compare, Stats>::memoryUsage() {
+    size_t totalBytes = sizeof(*this) + pool->bytesFor(numCells, pool == &ownPool);
+    return MemoryUsage(numCells * sizeof(ValueType), totalBytes);
+}
+
+/*
+ * Compare two values with the comparator, counting the comparison in the
+ *   stats.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool PairingHeapPriorityQueue<ValueType, Compare, Stats>::lessThan(const ValueType& a, const ValueType& b) {
+    Stats::countComparison();
+    return isLess(a, b);
+}
+
+#endif
@@ -0,0 +1,296 @@
+/**********************************************
+ * File: pqueue-perfcounters.h
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * Hardware performance counters for the benchmark, read through Linux's
+ * perf_event_open system call. Time alone does not say why one queue is
+ * faster than another; counting instructions, cache misses and branch
+ * mispredictions shows whether a queue loses on work done or on memory.
+ *
+ * The counters only count the calling thread, and only while it runs in
+ * user mode. That is what the benchmark wants, and it is also what an
+ * ordinary user may count when /proc/sys/kernel/perf_event_paranoid is 2
+ * or less, so no root access is needed. The counters are opened as one
+ * group led by the instruction counter, so that they are always counting
+ * over the same stretch of time. A counter that the processor or a virtual
+ * machine does not support is simply left out of the group. When the
+ * processor has too few counters free and the kernel has to take turns
+ * between groups, the totals are scaled up by the share of the time the
+ * group was actually counting. On other systems no counter is ever
+ * available.
+ */
+#ifndef PQueue_PerfCounters_Included
+#define PQueue_PerfCounters_Included
+
+#include <string>
+#include <fstream>
+#ifdef __linux__
+#include <cstring>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+using namespace std;
+
+/* Type: PerfCounterKind
+ * The events that a PerfCounters object counts.
+ */
+enum PerfCounterKind {
+	PERF_INSTRUCTIONS,
+	PERF_L1_MISSES,
+	PERF_LLC_MISSES,
+	PERF_BRANCH_MISSES,
+	NUM_PERF_COUNTERS
+};
+
+/* A class representing a set of hardware counters for the calling thread.
+ * The counters start out stopped at zero; they count while started, and
+ * keep their totals when stopped again.
+ */
+class PerfCounters {
+public:
+	/* Opens every counter the system allows. */
+	PerfCounters();
+
+	/* Closes the counters. */
+	~PerfCounters();
+
+	/* Returns whether the given counter could be opened. */
+	bool isAvailable(PerfCounterKind kind) const;
+
+	/* Returns whether any counter could be opened. */
+	bool isAnyAvailable() const;
+
+	/* Starts counting. */
+	void start();
+
+	/* Stops counting, keeping the totals so far. */
+	void stop();
+
+	/* Sets every total back to zero. */
+	void reset();
+
+	/* Returns the total of the given counter, or -1 if it is not available
+	 * or never got to count. If the group only counted part of the time it
+	 * was started, the total is scaled up to an estimate for all of it.
+	 */
+	long long value(PerfCounterKind kind) const;
+
+	/* Returns a short name for the given counter. */
+	static string name(PerfCounterKind kind);
+
+	/* Returns why no counter is available, for telling the user. */
+	static string unavailableReason();
+
+private:
+	// file descriptor of each counter, or -1 if it could not be opened
+	int counters[NUM_PERF_COUNTERS];
+
+	// file descriptor of the first counter opened, which leads the group,
+	//   or -1 if none could be opened
+	int leader;
+
+	// send the same request to the whole group
+	void controlAll(unsigned long request);
+
+	// disallow copying, since the counters are open files
+	PerfCounters(const PerfCounters&);
+	PerfCounters& operator=(const PerfCounters&);
+};
+
+/*************************************************************
+ * Implementation of the PerfCounters class. The functions are inline so
+ * that the header can be included in more than one source file.
+ */
+
+#ifdef __linux__
+
+/*
+ * Open a counter of the given type and configuration for the calling
+ *   thread on any processor, excluding the kernel and the hypervisor, in
+ *   the group led by groupLeader, or as the stopped leader of a new group
+ *   if groupLeader is -1. Reading the leader returns the whole group with
+ *   the time it was started and the time it was actually counting.
+ */
+inline int openPerfCounter(uint32_t type, uint64_t config, int groupLeader) {
+    struct perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = type;
+    attributes.config = config;
+    attributes.disabled = (groupLeader == -1) ? 1 : 0;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                             PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return int(syscall(__NR_perf_event_open, &attributes, 0, -1, groupLeader, 0));
+}
+
+/*
+ * Constructor to open each counter, in the order of PerfCounterKind, with
+ *   the first one that opens as the leader of the group. L1 misses are
+ *   data cache read misses; LLC misses are the processor's generic cache
+ *   miss event, which counts misses in the last level cache.
+ */
+inline PerfCounters::PerfCounters() : leader(-1) {
+    const uint32_t TYPES[NUM_PERF_COUNTERS] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE
+    };
+    const uint64_t CONFIGS[NUM_PERF_COUNTERS] = {
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+    for (int i = 0; i < NUM_PERF_COUNTERS; i++) {
+        counters[i] = openPerfCounter(TYPES[i], CONFIGS[i], leader);
+        if (leader == -1) leader = counters[i];
+    }
+}
+
+/*
+ * Destructor to close the counters that were opened.
+ */
+inline PerfCounters::~PerfCounters() {
+    for (int i = 0; i < NUM_PERF_COUNTERS; i++) {
+        if (counters[i] >= 0) close(counters[i]);
+    }
+}
+
+/*
+ * Send an ioctl request to the leader, for it and every counter in its
+ *   group.
+ */
+inline void PerfCounters::controlAll(unsigned long request) {
+    if (leader >= 0) ioctl(leader, request, PERF_IOC_FLAG_GROUP);
+}
+
+/*
+ * Start every open counter.
+ */
+inline void PerfCounters::start() {
+    controlAll(PERF_EVENT_IOC_ENABLE);
+}
+
+/*
+ * Stop every open counter.
+ */
+inline void PerfCounters::stop() {
+    controlAll(PERF_EVENT_IOC_DISABLE);
+}
+
+/*
+ * Set every open counter back to zero.
+ */
+inline void PerfCounters::reset() {
+    controlAll(PERF_EVENT_IOC_RESET);
+}
+
+/*
+ * Read the whole group from the leader, which the kernel hands back as the
+ *   number of counters, the time the group was started, the time it was
+ *   counting, and then each counter's total in the order they were opened.
+ *   The counter's total is scaled by the ratio of the two times.
+ */
+inline long long PerfCounters::value(PerfCounterKind kind) const {
+    if (counters[kind] < 0) return -1;
+    uint64_t group[3 + NUM_PERF_COUNTERS];
+    ssize_t bytesRead = read(leader, group, sizeof(group));
+    if (bytesRead < ssize_t(3 * sizeof(uint64_t))) return -1;
+
+    int position = 0;
+    for (int i = 0; i < kind; i++) {
+        if (counters[i] >= 0) position++;
+    }
+    if (uint64_t(position) >= group[0]) return -1;
+    uint64_t timeEnabled = group[1];
+    uint64_t timeRunning = group[2];
+    uint64_t total = group[3 + position];
+    if (timeRunning == 0) {
+        // never started, or started but never given a turn on the processor
+        return (timeEnabled == 0) ? 0 : -1;
+    }
+    if (timeRunning < timeEnabled) {
+        return (long long) (double(total) * double(timeEnabled) / double(timeRunning));
+    }
+    return (long long) total;
+}
+
+/*
+ * Explain the usual reason the counters cannot be opened: the paranoia
+ *   setting, or a system such as a container or virtual machine that does
+ *   not pass the counters through.
+ */
+inline string PerfCounters::unavailableReason() {
+    ifstream paranoid("/proc/sys/kernel/perf_event_paranoid");
+    int level;
+    if (!(paranoid >> level)) return "this kernel does not support perf events";
+    if (level > 2) {
+        return "perf_event_paranoid is " + to_string(level) + "; it must be 2 or less";
+    }
+    return "the processor or virtual machine does not expose the counters";
+}
+
+#else
+
+/*
+ * Without perf events, every counter is missing and the rest do nothing.
+ */
+inline PerfCounters::PerfCounters() : leader(-1) {
+    for (int i = 0; i < NUM_PERF_COUNTERS; i++) {
+        counters[i] = -1;
+    }
+}
+
+inline PerfCounters::~PerfCounters() {}
+inline void PerfCounters::controlAll(unsigned long) {}
+inline void PerfCounters::start() {}
+inline void PerfCounters::stop() {}
+inline void PerfCounters::reset() {}
+
+inline long long PerfCounters::value(PerfCounterKind) const {
+    return -1;
+}
+
+inline string PerfCounters::unavailableReason() {
+    return "hardware counters are only read on Linux";
+}
+
+#endif
+
+/*
+ * Check whether a counter was opened.
+ */
+inline bool PerfCounters::isAvailable(PerfCounterKind kind) const {
+    return counters[kind] >= 0;
+}
+
+/*
+ * Check whether any counter was opened.
+ */
+inline bool PerfCounters::isAnyAvailable() const {
+    for (int i = 0; i < NUM_PERF_COUNTERS; i++) {
+        if (counters[i] >= 0) return true;
+    }
+    return false;
+}
+
+/*
+ * Return the column heading of a counter.
+ */
+inline string PerfCounters::name(PerfCounterKind kind) {
+    switch (kind) {
+    case PERF_INSTRUCTIONS:  return "instr";
+    case PERF_L1_MISSES:     return "L1 miss";
+    case PERF_LLC_MISSES:    return "LLC miss";
+    case PERF_BRANCH_MISSES: return "br miss";
+    default:                 return "?";
+    }
+}
+
+#endif
@@ -0,0 +1,415 @@
+/**********************************************
+ * File: pqueue-radix.h
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * A priority queue class backed by a radix heap.
+ *
+ * Every value is summarized by a 64-bit key as described in
+ *   pqueue-packedkeys.h, and the values are sorted into buckets by how far
+ *   their key is from the key of the last value removed: bucket 0 holds the
+ *   values whose key equals it, and bucket i the values whose key first
+ *   differs from it in bit i - 1, counting from the lowest bit. An enqueue
+ *   only has to find the highest bit in which the two keys differ, so it
+ *   makes no comparisons at all.
+ *
+ * When bucket 0 runs empty, the smallest key in the lowest non-empty bucket
+ *   becomes the new last key and that bucket is emptied into the buckets
+ *   below it. Every value can only move down, and there are 65 buckets, so
+ *   this costs O(1) amortized per value as long as no value is enqueued
+ *   with a key below the last key removed, as in Dijkstra's algorithm or
+ *   an event simulation. Such a value is still allowed, but the buckets
+ *   then have to be rebuilt around its key, which takes O(n) time.
+ *
+ * Values with the same key, such as strings that share their first eight
+ *   characters, are kept in bucket 0 as a binary heap ordered by Compare,
+ *   which is the only place the comparator is ever called.
+ */
+#ifndef PQueue_Radix_Included
+#define PQueue_Radix_Included
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include "pqueue-packedkeys.h"
+#include "error.h"
+#include "pqueue-stats.h"
+#include "pqueue-memoryusage.h"
+using namespace std;
+
+/*
+ * Return the number of the bucket that a key belongs in when the last key
+ *   removed was lastKey: 0 if they are equal, and otherwise one more than
+ *   the highest bit in which they differ.
+ */
+inline int radixBucketOf(uint64_t key, uint64_t lastKey) {
+    uint64_t difference = key ^ lastKey;
+    if (difference == 0) return 0;
+#if defined(__GNUC__)
+    return 64 - __builtin_clzll(difference);
+#else
+    int bucket = 0;
+    while (difference != 0) {
+        difference >>= 1;
+        bucket++;
+    }
+    return bucket;
+#endif
+}
+
+/* A class representing a priority queue backed by a radix heap. Values
+ * are mapped to keys by KeyTraits, which must have packed keys that agree
+ * with Compare, such as StringPrefixKey for strings ordered by operator<.
+ *
+ * Stats is a stats policy from pqueue-stats.h. The moves it counts are the
+ * entries sorted into lower buckets when bucket 0 is refilled or the last
+ * key is lowered, and its resizes are the times a bucket grows.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare = less<ValueType>,
+          typename Stats = NoStats>
+class RadixPriorityQueue : private Stats {
+    static_assert(KeyTraits::IS_PACKED, "RadixPriorityQueue needs key traits with packed keys");
+
+  public:
+	/* Constructs a new, empty priority queue ordered by the given comparator. */
+	explicit RadixPriorityQueue(Compare compare = Compare());
+
+	/* Returns the number of elements in the priority queue. */
+	int size();
+
+	/* Returns whether or not the priority queue is empty. */
+	bool isEmpty();
+
+	/* Enqueues a copy of a value into the priority queue. */
+	void enqueue(const ValueType& value);
+
+	/* Enqueues a value into the priority queue, moving it into storage. */
+	void enqueue(ValueType&& value);
+
+	/* Enqueues a value constructed in place from the given arguments. */
+	template <typename... Args>
+	void emplace(Args&&... args);
+
+	/* Returns, but does not remove, the first value in the priority queue. */
+	const ValueType& peek();
+
+	/* Returns and removes the first value in the priority queue. */
+	ValueType dequeueMin();
+
+	/* Removes the k smallest values from the priority queue and writes them
+	 * to out in sorted order. Returns the output iterator one past the last
+	 * value written.
+	 */
+	template <typename OutputIterator>
+	OutputIterator dequeueMin(int k, OutputIterator out);
+
+	/* Removes every value from the priority queue. */
+	void clear();
+
+	/* Moves every value of other into this priority queue, leaving other
+	 * empty. The keys of other are reused rather than computed again, and
+	 * no value is copied.
+	 */
+	void merge(RadixPriorityQueue& other);
+
+	/* Returns the stats the queue has kept so far. */
+	const Stats& stats();
+
+	/* Returns the bytes the queue takes, split into the values and the
+	 * overhead of their keys and of the spare capacity of the buckets.
+	 */
+	MemoryUsage memoryUsage();
+
+  private:
+    // a value together with its key
+    struct Entry {
+        uint64_t key;
+        ValueType value;
+    };
+
+    // one bucket for equal keys and one for each bit in which they can differ
+    static const int NUM_BUCKETS = 65;
+    vector<Entry> buckets[NUM_BUCKETS];
+
+    // key of the last value removed; every key in the queue is at least this
+    uint64_t lastKey;
+
+    // number of values in all buckets
+    int numValues;
+
+    // comparator deciding which of two values comes first
+    Compare isLess;
+
+    // add an entry to its bucket, lowering the last key first if the
+    //   entry's key is below it
+    void insertEntry(Entry&& entry);
+
+    // lower the last key to a key below it, which takes O(n) time
+    void lowerLastKey(uint64_t key);
+
+    // add an entry to its bucket, which must not be below the last key
+    void placeEntry(Entry&& entry);
+
+    // make sure bucket 0 holds the smallest values
+    void refillFirstBucket();
+
+    // order for the binary heap in bucket 0, whose top is the smallest value
+    bool isGreaterEntry(const Entry& first, const Entry& second);
+};
+
+/*************************************************************
+ * Implementation of the RadixPriorityQueue class. Since the class is a
+ * template, the implementation has to be visible in the header.
+ */
+
+/*
+ * Constructor to start with empty buckets.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::RadixPriorityQueue(Compare compare)
+    : isLess(compare) {
+    lastKey = 0;
+    numValues = 0;
+}
+
+/*
+ * Return the current size of the queue.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+int RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::size() {
+    return numValues;
+}
+
+/*
+ * Return whether the queue is empty.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+bool RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::isEmpty() {
+    return (numValues == 0);
+}
+
+/*
+ * Add a copy of a value to the queue.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+void RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::enqueue(const ValueType& value) {
+    emplace(value);
+}
+
+/*
+ * Add a value to the queue without copying it.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+void RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::enqueue(ValueType&& value) {
+    emplace(std::move(value));
+}
+
+/*
+ * Construct a value, work out its key and add it to its bucket.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+template <typename... Args>
+void RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::emplace(Args&&... args) {
+    typename Stats::Timer timer(*this, STATS_ENQUEUE);
+    ValueType value(std::forward<Args>(args)...);
+    uint64_t key = KeyTraits::key(value);
+    Entry entry = { key, std::move(value) };
+    insertEntry(std::move(entry));
+}
+
+/*
+ * Look at the smallest value, which is on top of the heap in bucket 0.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+const ValueType& RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::peek() {
+    if (isEmpty()) error("The queue is empty");
+
+    refillFirstBucket();
+    return buckets[0].front().value;
+}
+
+/*
+ * Remove and return the smallest value in the queue.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+ValueType RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::dequeueMin() {
+    typename Stats::Timer timer(*this, STATS_DEQUEUE);
+    if (isEmpty()) error("The queue is empty");
+
+    refillFirstBucket();
+    vector<Entry>& first = buckets[0];
+    pop_heap(first.begin(), first.end(),
+             [this](const Entry& a, const Entry& b) { return isGreaterEntry(a, b); });
+    ValueType val = std::move(first.back().value);
+    first.pop_back();
+    numValues--;
+    return val;
+}
+
+/*
+ * Remove the k smallest values from the queue. Each removal is already
+ *   O(1) amortized, so they are simply taken one at a time.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+template <typename OutputIterator>
+OutputIterator RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::dequeueMin(int k, OutputIterator out) {
+    if (k < 0 || k > size()) error("Cannot dequeue more values than the queue holds");
+
+    for (int i = 0; i < k; i++) {
+        *out++ = dequeueMin();
+    }
+    return out;
+}
+
+/*
+ * Remove every value from the queue. The buckets keep their memory for
+ *   the values that are added next.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+void RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::clear() {
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        buckets[i].clear();
+    }
+    lastKey = 0;
+    numValues = 0;
+}
+
+/*
+ * Merge another queue into this one by moving its entries into the
+ *   buckets of this queue.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+void RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::merge(RadixPriorityQueue& other) {
+    if (&other == this || other.isEmpty()) return;
+
+    // every key of other is at least its last key, so lowering this
+    //   queue's last key that far once makes room for all of them
+    if (isEmpty()) {
+        lastKey = other.lastKey;
+    } else if (other.lastKey < lastKey) {
+        lowerLastKey(other.lastKey);
+    }
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        for (size_t j = 0; j < other.buckets[i].size(); j++) {
+            placeEntry(std::move(other.buckets[i][j]));
+        }
+    }
+    numValues += other.numValues;
+    other.clear();
+}
+
+/*
+ * Add an entry to its bucket. An empty queue can simply start over from
+ *   the new key.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+void RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::insertEntry(Entry&& entry) {
+    if (isEmpty()) {
+        lastKey = entry.key;
+    } else if (entry.key < lastKey) {
+        lowerLastKey(entry.key);
+    }
+    placeEntry(std::move(entry));
+    numValues++;
+}
+
+/*
+ * Lower the last key and sort every entry into its bucket again.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+void RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::lowerLastKey(uint64_t key) {
+    lastKey = key;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        vector<Entry> bucket;
+        bucket.swap(buckets[i]);
+        Stats::countMoves(bucket.size());
+        for (size_t j = 0; j < bucket.size(); j++) {
+            placeEntry(std::move(bucket[j]));
+        }
+    }
+}
+
+/*
+ * Add an entry to the bucket for its key, keeping bucket 0 a heap.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+void RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::placeEntry(Entry&& entry) {
+    int bucket = radixBucketOf(entry.key, lastKey);
+    if (buckets[bucket].size() == buckets[bucket].capacity()) {
+        Stats::countResize();
+    }
+    buckets[bucket].push_back(std::move(entry));
+    if (bucket == 0) {
+        push_heap(buckets[0].begin(), buckets[0].end(),
+                  [this](const Entry& a, const Entry& b) { return isGreaterEntry(a, b); });
+    }
+}
+
+/*
+ * If bucket 0 is empty, make the smallest key in the lowest non-empty
+ *   bucket the last key and redistribute that bucket. Its entries all
+ *   agree with the new last key above their bucket's bit, so each of them
+ *   lands in a lower bucket, and the ones with the smallest key in bucket 0.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+void RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::refillFirstBucket() {
+    if (!buckets[0].empty()) return;
+
+    int lowest = 1;
+    while (buckets[lowest].empty()) {
+        lowest++;
+    }
+
+    vector<Entry> bucket;
+    bucket.swap(buckets[lowest]);
+    uint64_t smallestKey = bucket[0].key;
+    for (size_t i = 1; i < bucket.size(); i++) {
+        if (bucket[i].key < smallestKey) smallestKey = bucket[i].key;
+    }
+    lastKey = smallestKey;
+    Stats::countMoves(bucket.size());
+    for (size_t i = 0; i < bucket.size(); i++) {
+        placeEntry(std::move(bucket[i]));
+    }
+
+    // hand the memory back so the bucket does not have to grow again
+    bucket.clear();
+    buckets[lowest].swap(bucket);
+}
+
+/*
+ * Compare two entries of bucket 0, which share their key, so that the
+ *   standard heap functions keep the smallest value on top.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+bool RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::isGreaterEntry(const Entry& first, const Entry& second) {
+    Stats::countComparison();
+    return isLess(second.value, first.value);
+}
+
+/*
+ * Return the stats kept so far.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+const Stats& RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::stats() {
+    return *this;
+}
+
+/*
+ * Count the capacity of every bucket; each entry holds a key as well as
+ *   a value.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+MemoryUsage RadixPriorityQueue<ValueType, KeyTraits, Compare, Stats>::memoryUsage() {
+    size_t totalBytes = sizeof(*this);
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        totalBytes += buckets[i].capacity() * sizeof(Entry);
+    }
+    return MemoryUsage(numValues * sizeof(ValueType), totalBytes);
+}
+
+#endif
@@ -0,0 +1,537 @@
+/**********************************************
+ * File: pqueue-skiplist.h
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * A priority queue class backed by a skip list.
+ *
+ * Like the LinkedListPriorityQueue, the values are kept in a sorted,
+ *   singly-linked list, so the smallest value is always at the front and
+ *   peek() and dequeueMin() run in O(1) time. The difference is in how a
+ *   new value finds its place. Besides its link to the next cell, every
+ *   cell has a random number of extra links that skip over several cells
+ *   at once: about a quarter of the cells have a link on level 1, about a
+ *   sixteenth have one on level 2 and so on. An enqueue starts on the
+ *   highest level, follows links as long as they do not overshoot the new
+ *   value, and drops down a level when they would, so it only looks at a
+ *   few cells per level and runs in O(log n) expected time instead of
+ *   walking the whole list.
+ *
+ * Because the values stay sorted, the queue can also be iterated in order
+ *   and a whole range of values can be removed at once.
+ */
+#ifndef PQueue_SkipList_Included
+#define PQueue_SkipList_Included
+
+#include <string>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <new>
+#include <cstddef>
+#include <iostream>
+#include "simpio.h"
+#include "error.h"
+#include "pqueue-stats.h"
+#include "pqueue-memoryusage.h"
+using namespace std;
+
+/* Type: SkipCell
+ * A cell in a skip list. The cell is followed in memory by an array of
+ * level links to the next cell on each level; level 0 links every cell.
+ * The cell is aligned for those links as well as for its value.
+ */
+template <typename ValueType>
+struct alignas(void*) alignas(ValueType) SkipCell {
+	ValueType value;
+
+	// number of levels this cell is linked into
+	int level;
+
+	/* Constructs the value in place from the given arguments. */
+	template <typename... Args>
+	explicit SkipCell(Args&&... args) : value(std::forward<Args>(args)...) {}
+
+	/* Returns the array of links that follows the cell. */
+	SkipCell** next() {
+		return reinterpret_cast<SkipCell**>(this + 1);
+	}
+};
+
+/* A class representing a priority queue backed by a skip list. Values are
+ * ordered by Compare, which defaults to operator<. Stats is a stats policy
+ * from pqueue-stats.h; a skip list only ever relinks its cells, so
+ * comparisons and latencies are all it has to count.
+ */
+template <typename ValueType, typename Compare = less<ValueType>, typename Stats = NoStats>
+class SkipListPriorityQueue : private Stats {
+public:
+	/* Constructs a new, empty priority queue backed by a skip list. */
+	explicit SkipListPriorityQueue(Compare compare = Compare());
+
+	/* Cleans up all memory allocated by this priority queue. */
+	~SkipListPriorityQueue();
+
+	/* Returns the number of elements in the priority queue. */
+	int size();
+
+	/* Returns whether or not the priority queue is empty. */
+	bool isEmpty();
+
+	/* Enqueues a copy of a value into the priority queue. */
+	void enqueue(const ValueType& value);
+
+	/* Enqueues a value into the priority queue, moving it into storage. */
+	void enqueue(ValueType&& value);
+
+	/* Enqueues a value constructed in place from the given arguments. */
+	template <typename... Args>
+	void emplace(Args&&... args);
+
+	/* Returns, but does not remove, the first value in the priority queue. */
+	const ValueType& peek();
+
+	/* Returns and removes the first value in the priority queue. */
+	ValueType dequeueMin();
+
+	/* Removes the k smallest values from the priority queue and writes them
+	 * to out in sorted order. Returns the output iterator one past the last
+	 * value written.
+	 */
+	template <typename OutputIterator>
+	OutputIterator dequeueMin(int k, OutputIterator out);
+
+	/* Removes every value from the priority queue. */
+	void clear();
+
+	/* Moves every value of other into this priority queue, leaving other
+	 * empty. The cells of other are relinked into this list one at a time,
+	 * in O(log n) expected time each, and no value is copied.
+	 */
+	void merge(SkipListPriorityQueue& other);
+
+	/* Removes every value that is not less than low but is less than high,
+	 * and returns how many values were removed.
+	 */
+	int removeRange(const ValueType& low, const ValueType& high);
+
+	/* An iterator that visits the values in sorted order. The values cannot
+	 * be changed through it, since that could break the order of the list.
+	 * Enqueuing or removing values invalidates the iterators pointing at
+	 * the removed values only.
+	 */
+	class const_iterator {
+	public:
+		typedef forward_iterator_tag iterator_category;
+		typedef ValueType value_type;
+		typedef ptrdiff_t difference_type;
+		typedef const ValueType* pointer;
+		typedef const ValueType& reference;
+
+		const_iterator() : cell(NULL) {}
+		const ValueType& operator*() const { return cell->value; }
+		const ValueType* operator->() const { return &cell->value; }
+		const_iterator& operator++() {
+			cell = cell->next()[0];
+			return *this;
+		}
+		const_iterator operator++(int) {
+			const_iterator copy = *this;
+			++*this;
+			return copy;
+		}
+		bool operator==(const const_iterator& other) const { return cell == other.cell; }
+		bool operator!=(const const_iterator& other) const { return cell != other.cell; }
+
+	private:
+		explicit const_iterator(SkipCell<ValueType>* cell) : cell(cell) {}
+		SkipCell<ValueType>* cell;
+		friend class SkipListPriorityQueue;
+	};
+
+	/* Returns iterators to the smallest value and past the largest value. */
+	const_iterator begin() const;
+	const_iterator end() const;
+
+	/* Returns the stats the queue has kept so far. */
+	const Stats& stats();
+
+	/* Returns the bytes the list takes, split into the values and the
+	 * overhead of their cells and links. Since cells have different numbers
+	 * of links, this walks the list and takes linear time.
+	 */
+	MemoryUsage memoryUsage();
+
+private:
+	// the highest number of levels a cell can have. Since each level has
+	//   a quarter of the cells of the level below, this is enough for
+	//   4^16 cells.
+	static const int MAX_LEVEL = 16;
+
+	// links from the front of the list to the first cell on each level
+	SkipCell<ValueType>* head[MAX_LEVEL];
+
+	// number of levels in use; head[i] is NULL for every higher level
+	int numLevels;
+
+	// number of cells in the list
+	int listSize;
+
+	// comparator deciding which of two values comes first
+	Compare isLess;
+
+	// compare two values, counting the comparison
+	bool lessThan(const ValueType& a, const ValueType& b);
+
+	// state of the random number generator used to pick cell levels
+	unsigned int randomState;
+
+	// pick the number of levels for a new cell
+	int randomLevel();
+
+	// the links leaving a cell, or the head links if cell is NULL
+	SkipCell<ValueType>** linksOf(SkipCell<ValueType>* cell);
+
+	// link a cell into the list at its sorted position
+	void insertCell(SkipCell<ValueType>* newCell);
+
+	// unlink the first cell, giving back the cell it was in
+	SkipCell<ValueType>* unlinkFirst();
+
+	// allocate a cell together with its links, and free it again
+	template <typename... Args>
+	static SkipCell<ValueType>* createCell(int level, Args&&... args);
+	static void destroyCell(SkipCell<ValueType>* cell);
+
+	// the list owns its cells, so it cannot be copied
+	SkipListPriorityQueue(const SkipListPriorityQueue&);
+	SkipListPriorityQueue& operator=(const SkipListPriorityQueue&);
+};
+
+/*************************************************************
+ * Implementation of the SkipListPriorityQueue class. Since the class is
+ * a template, the implementation has to be visible in the header.
+ */
+
+/*
+ * Constructor to start the list empty.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+SkipListPriorityQueue<ValueType, Compare, Stats>::SkipListPriorityQueue(Compare compare)
+    : isLess(compare) {
+    for (int i = 0; i < MAX_LEVEL; i++) {
+        head[i] = NULL;
+    }
+    numLevels = 1;
+    listSize = 0;
+    randomState = 2463534242u;
+}
+
+/*
+ * Destructor to free every cell.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+SkipListPriorityQueue<ValueType, Compare, Stats>::~SkipListPriorityQueue() {
+    clear();
+}
+
+/*
+ * Return the size of the list.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int SkipListPriorityQueue<ValueType, Compare, Stats>::size() {
+    return listSize;
+}
+
+/*
+ * Return whether the list is empty.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool SkipListPriorityQueue<ValueType, Compare, Stats>::isEmpty() {
+    return (listSize == 0);
+}
+
+/*
+ * Add a copy of a value to the queue.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void SkipListPriorityQueue<ValueType, Compare, Stats>::enqueue(const ValueType& value) {
+    emplace(value);
+}
+
+/*
+ * Add a value to the queue, moving it into its cell rather than copying it.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void SkipListPriorityQueue<ValueType, Compare, Stats>::enqueue(ValueType&& value) {
+    emplace(std::move(value));
+}
+
+/*
+ * Add a value to the list, constructing it directly inside its new cell.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename... Args>
+void SkipListPriorityQueue<ValueType, Compare, Stats>::emplace(Args&&... args) {
+    typename Stats::Timer timer(*this, STATS_ENQUEUE);
+    insertCell(createCell(randomLevel(), std::forward<Args>(args)...));
+}
+
+/*
+ * Link a cell into the list at its sorted position. On each level,
+ *   starting from the highest, the search moves forward until the next cell
+ *   would not come before the new value, and remembers the link it stopped
+ *   at. The new cell is then spliced into those links on each of its
+ *   levels. Equal values end up in the order they were added.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void SkipListPriorityQueue<ValueType, Compare, Stats>::insertCell(SkipCell<ValueType>* newCell) {
+    int level = newCell->level;
+    if (level > numLevels) {
+        numLevels = level;
+    }
+
+    SkipCell<ValueType>* curr = NULL;
+    for (int i = numLevels - 1; i >= 0; i--) {
+        SkipCell<ValueType>** links = linksOf(curr);
+        while (links[i] != NULL && !lessThan(newCell->value, links[i]->value)) {
+            curr = links[i];
+            links = curr->next();
+        }
+        if (i < level) {
+            newCell->next()[i] = links[i];
+            links[i] = newCell;
+        }
+    }
+    listSize++;
+}
+
+/*
+ * Look at the smallest element, which is always the first cell.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+const ValueType& SkipListPriorityQueue<ValueType, Compare, Stats>::peek() {
+    if (isEmpty()) error("Cannot peek at an empty list");
+    return head[0]->value;
+}
+
+/*
+ * Remove the first cell and return its value.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+ValueType SkipListPriorityQueue<ValueType, Compare, Stats>::dequeueMin() {
+    typename Stats::Timer timer(*this, STATS_DEQUEUE);
+    if (isEmpty()) error("Cannot dequeue from an empty list");
+    SkipCell<ValueType>* first = unlinkFirst();
+    ValueType val = std::move(first->value);
+    destroyCell(first);
+    return val;
+}
+
+/*
+ * Remove the k smallest elements, which are the first k cells.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename OutputIterator>
+OutputIterator SkipListPriorityQueue<ValueType, Compare, Stats>::dequeueMin(int k, OutputIterator out) {
+    if (k < 0 || k > listSize) error("Cannot dequeue more values than the list holds");
+    for (int i = 0; i < k; i++) {
+        SkipCell<ValueType>* first = unlinkFirst();
+        *out++ = std::move(first->value);
+        destroyCell(first);
+    }
+    return out;
+}
+
+/*
+ * Remove every element, walking the bottom level of the list once.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void SkipListPriorityQueue<ValueType, Compare, Stats>::clear() {
+    SkipCell<ValueType>* curr = head[0];
+    while (curr != NULL) {
+        SkipCell<ValueType>* next = curr->next()[0];
+        destroyCell(curr);
+        curr = next;
+    }
+    for (int i = 0; i < MAX_LEVEL; i++) {
+        head[i] = NULL;
+    }
+    numLevels = 1;
+    listSize = 0;
+}
+
+/*
+ * Merge another list into this one. Its cells are unlinked from its front
+ *   and relinked into this list, keeping the levels they already have.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void SkipListPriorityQueue<ValueType, Compare, Stats>::merge(SkipListPriorityQueue& other) {
+    if (&other == this) return;
+    while (!other.isEmpty()) {
+        insertCell(other.unlinkFirst());
+    }
+}
+
+/*
+ * Remove every element in [low, high). The links leading up to low are
+ *   found the same way enqueue() finds them. Since the range is
+ *   contiguous, the cells in it are then unlinked one after another from
+ *   those same links.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int SkipListPriorityQueue<ValueType, Compare, Stats>::removeRange(const ValueType& low, const ValueType& high) {
+    SkipCell<ValueType>** update[MAX_LEVEL];
+    SkipCell<ValueType>* curr = NULL;
+    for (int i = numLevels - 1; i >= 0; i--) {
+        SkipCell<ValueType>** links = linksOf(curr);
+        while (links[i] != NULL && lessThan(links[i]->value, low)) {
+            curr = links[i];
+            links = curr->next();
+        }
+        update[i] = links;
+    }
+
+    int numRemoved = 0;
+    SkipCell<ValueType>* toRemove = update[0][0];
+    while (toRemove != NULL && lessThan(toRemove->value, high)) {
+        SkipCell<ValueType>* next = toRemove->next()[0];
+        for (int i = 0; i < toRemove->level; i++) {
+            update[i][i] = toRemove->next()[i];
+        }
+        destroyCell(toRemove);
+        numRemoved++;
+        toRemove = next;
+    }
+
+    listSize -= numRemoved;
+    while (numLevels > 1 && head[numLevels - 1] == NULL) {
+        numLevels--;
+    }
+    return numRemoved;
+}
+
+/*
+ * Return an iterator to the first cell.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+typename SkipListPriorityQueue<ValueType, Compare, Stats>::const_iterator
+SkipListPriorityQueue<ValueType, Compare, Stats>::begin() const {
+    return const_iterator(head[0]);
+}
+
+/*
+ * Return an iterator past the last cell.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+typename SkipListPriorityQueue<ValueType, Compare, Stats>::const_iterator
+SkipListPriorityQueue<ValueType, Compare, Stats>::end() const {
+    return const_iterator();
+}
+
+/*
+ * Pick a level for a new cell: one level, plus one more with probability
+ *   1/4 each time, up to MAX_LEVEL. Two random bits are used per level,
+ *   taken from a xorshift generator, which is far cheaper than the
+ *   library's random numbers and good enough for balancing the list.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+int SkipListPriorityQueue<ValueType, Compare, Stats>::randomLevel() {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    unsigned int bits = randomState;
+    int level = 1;
+    while (level < MAX_LEVEL && (bits & 3) == 0) {
+        level++;
+        bits >>= 2;
+    }
+    return level;
+}
+
+/*
+ * Return the links leaving a cell; NULL stands for the front of the list.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+SkipCell<ValueType>** SkipListPriorityQueue<ValueType, Compare, Stats>::linksOf(SkipCell<ValueType>* cell) {
+    return (cell == NULL) ? head : cell->next();
+}
+
+/*
+ * Unlink the first cell from every level it is on. Since it is the first
+ *   cell, it is linked from the head on each of those levels.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+SkipCell<ValueType>* SkipListPriorityQueue<ValueType, Compare, Stats>::unlinkFirst() {
+    SkipCell<ValueType>* first = head[0];
+    for (int i = 0; i < first->level; i++) {
+        head[i] = first->next()[i];
+    }
+    while (numLevels > 1 && head[numLevels - 1] == NULL) {
+        numLevels--;
+    }
+    listSize--;
+    return first;
+}
+
+/*
+ * Allocate a cell with room for its links right after it, so that each
+ *   cell takes a single allocation however many levels it has.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+template <typename... Args>
+SkipCell<ValueType>* SkipListPriorityQueue<ValueType, Compare, Stats>::createCell(int level, Args&&... args) {
+    void* memory = ::operator new(sizeof(SkipCell<ValueType>) + level * sizeof(SkipCell<ValueType>*));
+    SkipCell<ValueType>* cell;
+    try {
+        cell = new (memory) SkipCell<ValueType>(std::forward<Args>(args)...);
+    } catch (...) {
+        ::operator delete(memory);
+        throw;
+    }
+    cell->level = level;
+    return cell;
+}
+
+/*
+ * Destroy a cell's value and free its memory.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+void SkipListPriorityQueue<ValueType, Compare, Stats>::destroyCell(SkipCell<ValueType>* cell) {
+    cell->~SkipCell<ValueType>();
+    ::operator delete(cell);
+}
+
+/*
+ * Return the stats kept so far.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+const Stats& SkipListPriorityQueue<ValueType, Compare, Stats>::stats() {
+    return *this;
+}
+
+/*
+ * Walk the lowest level, adding up each cell with the links that follow
+ *   it.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+MemoryUsage SkipListPriorityQueue<ValueType, Compare, Stats>::memoryUsage() {
+    size_t totalBytes = sizeof(*this);
+    for (SkipCell<ValueType>* curr = head[0]; curr != NULL; curr = curr->next()[0]) {
+        totalBytes += sizeof(SkipCell<ValueType>) + curr->level * sizeof(SkipCell<ValueType>*);
+    }
+    return MemoryUsage(listSize * sizeof(ValueType), totalBytes);
+}
+
+/*
+ * Compare two values with the comparator, counting the comparison in the
+ *   stats.
+ */
+template <typename ValueType, typename Compare, typename Stats>
+bool SkipListPriorityQueue<ValueType, Compare, Stats>::lessThan(const ValueType& a, const ValueType& b) {
+    Stats::countComparison();
+    return isLess(a, b);
+}
+
+#endif
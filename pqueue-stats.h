@@ -0,0 +1,286 @@
+/**********************************************
+ * File: pqueue-stats.h
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * Stats policies let a priority queue count the work it does, for tuning a
+ *   queue against a real workload. A queue takes its policy as its last
+ *   template argument, inherits from it, and calls the policy at every
+ *   comparison, every move of a value within its storage, every time its
+ *   storage grows, and at the consolidations and links of the heaps built
+ *   from trees. It also times each enqueue and dequeueMin.
+ *
+ * Every queue uses NoStats unless it is told otherwise. NoStats is an empty
+ *   class whose functions do nothing, so the compiler removes every call and
+ *   the empty base takes no space: a queue without stats is the same size
+ *   and runs the same code as before. CountingStats keeps the counts and a
+ *   latency histogram for each operation. Its counters are atomic, so the
+ *   concurrent queues can update them from several threads at once, but
+ *   they are updated with relaxed ordering and do not synchronize anything.
+ *
+ * A stats policy class has the functions countComparison(), countMoves(n),
+ *   countResize(), countConsolidation(), countLink() and addCounts(other),
+ *   and a nested class Timer whose constructor takes the policy and a
+ *   StatsOperation and which times the operation until it is destroyed.
+ */
+#ifndef PQueue_Stats_Included
+#define PQueue_Stats_Included
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+using namespace std;
+
+/* Type: StatsOperation
+ * The operations whose latencies a stats policy records.
+ */
+enum StatsOperation {
+    STATS_ENQUEUE,
+    STATS_DEQUEUE,
+    NUM_STATS_OPERATIONS
+};
+
+/* Stats policy for a queue that keeps no stats. */
+class NoStats {
+public:
+    /* A timer that does not time anything. */
+    class Timer {
+    public:
+        Timer(NoStats&, StatsOperation) {}
+    };
+
+    void countComparison() {}
+    void countMoves(long) {}
+    void countResize() {}
+    void countConsolidation() {}
+    void countLink() {}
+    void addCounts(const NoStats&) {}
+};
+
+/* A histogram of latencies in nanoseconds, in the style of an HDR
+ * histogram. Latencies below 16ns each have a bucket of their own; above
+ * that, every power of two is split into 16 buckets, so a latency is
+ * placed to within about 6% however large it is, with a fixed number of
+ * buckets and no allocation. A histogram may be recorded into from several
+ * threads at once.
+ */
+class LatencyHistogram {
+public:
+    /* Constructs an empty histogram. */
+    LatencyHistogram() {
+        reset();
+    }
+
+    /* Constructs a histogram holding the counts of other at this moment. */
+    LatencyHistogram(const LatencyHistogram& other) {
+        reset();
+        add(other);
+    }
+
+    /* Records one latency. */
+    void record(long long nanoseconds) {
+        buckets[bucketIndex(nanoseconds < 0 ? 0 : uint64_t(nanoseconds))]
+            .fetch_add(1, memory_order_relaxed);
+    }
+
+    /* Returns the number of latencies recorded. */
+    long long count() const {
+        long long total = 0;
+        for (int i = 0; i < NUM_BUCKETS; i++) {
+            total += buckets[i].load(memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /* Returns the latency that percent percent of the recorded latencies do
+     * not exceed, rounded up to the top of its bucket, or 0 if nothing has
+     * been recorded.
+     */
+    long long percentile(double percent) const {
+        long long total = count();
+        if (total == 0) return 0;
+        long long rank = (long long)(percent / 100 * total + 0.5);
+        if (rank < 1) rank = 1;
+        if (rank > total) rank = total;
+        long long seen = 0;
+        for (int i = 0; i < NUM_BUCKETS; i++) {
+            seen += buckets[i].load(memory_order_relaxed);
+            if (seen >= rank) return bucketHighest(i);
+        }
+        return bucketHighest(NUM_BUCKETS - 1);
+    }
+
+    /* Adds the counts of other to this histogram. */
+    void add(const LatencyHistogram& other) {
+        for (int i = 0; i < NUM_BUCKETS; i++) {
+            buckets[i].fetch_add(other.buckets[i].load(memory_order_relaxed),
+                                 memory_order_relaxed);
+        }
+    }
+
+    /* Empties the histogram. */
+    void reset() {
+        for (int i = 0; i < NUM_BUCKETS; i++) {
+            buckets[i].store(0, memory_order_relaxed);
+        }
+    }
+
+private:
+    // bits of a latency kept below its highest set bit, and the number of
+    //   buckets this gives for 64-bit latencies
+    static const int SUB_BUCKET_BITS = 4;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    // number of latencies recorded in each bucket
+    atomic<long long> buckets[NUM_BUCKETS];
+
+    // bucket of a latency: small latencies map to themselves, larger ones
+    //   to their power of two and the bits that follow the highest one
+    static int bucketIndex(uint64_t value) {
+        if (value < uint64_t(SUB_BUCKETS)) return int(value);
+        int exponent = 63;
+        while ((value >> exponent) == 0) exponent--;
+        int shift = exponent - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKETS + int((value >> shift) & (SUB_BUCKETS - 1));
+    }
+
+    // smallest and largest latency that falls in a bucket
+    static long long bucketLowest(int index) {
+        if (index < SUB_BUCKETS) return index;
+        int shift = index / SUB_BUCKETS - 1;
+        return (long long)(uint64_t(SUB_BUCKETS + index % SUB_BUCKETS) << shift);
+    }
+    static long long bucketHighest(int index) {
+        if (index == NUM_BUCKETS - 1) return (long long)(~uint64_t(0) >> 1);
+        return bucketLowest(index + 1) - 1;
+    }
+
+    LatencyHistogram& operator=(const LatencyHistogram&);
+};
+
+/* Stats policy for a queue that counts its work and times its operations. */
+class CountingStats {
+public:
+    /* A timer that records the time from its construction to its
+     * destruction in the histogram of one operation.
+     */
+    class Timer {
+    public:
+        Timer(CountingStats& stats, StatsOperation operation)
+            : stats(stats), operation(operation), begin(chrono::steady_clock::now()) {}
+
+        ~Timer() {
+            chrono::nanoseconds elapsed = chrono::steady_clock::now() - begin;
+            stats.histograms[operation].record(elapsed.count());
+        }
+
+    private:
+        CountingStats& stats;
+        StatsOperation operation;
+        chrono::steady_clock::time_point begin;
+    };
+
+    /* Constructs stats with every count at zero. */
+    CountingStats() {
+        resetStats();
+    }
+
+    /* Constructs a copy of the stats of other at this moment. */
+    CountingStats(const CountingStats& other) {
+        resetStats();
+        addCounts(other);
+        for (int i = 0; i < NUM_STATS_OPERATIONS; i++) {
+            histograms[i].add(other.histograms[i]);
+        }
+    }
+
+    void countComparison() {
+        numComparisons.fetch_add(1, memory_order_relaxed);
+    }
+
+    void countMoves(long n) {
+        numMoves.fetch_add(n, memory_order_relaxed);
+    }
+
+    void countResize() {
+        numResizes.fetch_add(1, memory_order_relaxed);
+    }
+
+    void countConsolidation() {
+        numConsolidations.fetch_add(1, memory_order_relaxed);
+    }
+
+    void countLink() {
+        numLinks.fetch_add(1, memory_order_relaxed);
+    }
+
+    /* Returns the number of times two values were compared. */
+    long long comparisons() const {
+        return numComparisons.load(memory_order_relaxed);
+    }
+
+    /* Returns the number of times a value was moved from one place in the
+     * queue's storage to another, not counting moves into and out of it.
+     */
+    long long moves() const {
+        return numMoves.load(memory_order_relaxed);
+    }
+
+    /* Returns the number of times the queue's storage was grown. */
+    long long resizes() const {
+        return numResizes.load(memory_order_relaxed);
+    }
+
+    /* Returns the number of consolidation passes over the root list. */
+    long long consolidations() const {
+        return numConsolidations.load(memory_order_relaxed);
+    }
+
+    /* Returns the number of times one tree was linked under another. */
+    long long links() const {
+        return numLinks.load(memory_order_relaxed);
+    }
+
+    /* Returns the histogram of the latencies of an operation. */
+    const LatencyHistogram& latency(StatsOperation operation) const {
+        return histograms[operation];
+    }
+
+    /* Adds the counts of other to these, leaving the latencies alone. The
+     * queues built from other queues use this to gather the counts of the
+     * queues inside them, whose operations they have already timed.
+     */
+    void addCounts(const CountingStats& other) {
+        numComparisons.fetch_add(other.comparisons(), memory_order_relaxed);
+        numMoves.fetch_add(other.moves(), memory_order_relaxed);
+        numResizes.fetch_add(other.resizes(), memory_order_relaxed);
+        numConsolidations.fetch_add(other.consolidations(), memory_order_relaxed);
+        numLinks.fetch_add(other.links(), memory_order_relaxed);
+    }
+
+    /* Sets every count back to zero and empties the histograms. */
+    void resetStats() {
+        numComparisons.store(0, memory_order_relaxed);
+        numMoves.store(0, memory_order_relaxed);
+        numResizes.store(0, memory_order_relaxed);
+        numConsolidations.store(0, memory_order_relaxed);
+        numLinks.store(0, memory_order_relaxed);
+        for (int i = 0; i < NUM_STATS_OPERATIONS; i++) {
+            histograms[i].reset();
+        }
+    }
+
+private:
+    atomic<long long> numComparisons;
+    atomic<long long> numMoves;
+    atomic<long long> numResizes;
+    atomic<long long> numConsolidations;
+    atomic<long long> numLinks;
+    LatencyHistogram histograms[NUM_STATS_OPERATIONS];
+
+    CountingStats& operator=(const CountingStats&);
+};
+
+#endif
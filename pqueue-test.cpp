@@ -20,6 +20,15 @@
 #include "pqueue-doublylinkedlist.h"
 #include "pqueue-heap.h"
 #include "pqueue-fibonacciheap.h"
+#include "pqueue-skiplist.h"
+#include "pqueue-pairingheap.h"
+#include "pqueue-radix.h"
+#include "pqueue-concurrentheap.h"
+#include "pqueue-multiqueue.h"
+#include "pqueue-workstealing.h"
+#include "pqueue-lockfreeskiplist.h"
+#include "pqueue-alloccount.h"
+#include "pqueue-benchmark.h"
 #include "random.h"
 #include "simpio.h"
 #include "vector.h"
@@ -30,6 +39,13 @@
 #include <sstream>    // For istringstream
 #include <algorithm>  // For sort, reverse
 #include <functional> // For greater
+#include <iterator>   // For istream_iterator, make_move_iterator
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>     // For sleep_for
+#include <random>     // For minstd_rand, which each thread can own
 using namespace std;
 
 /* Macro: checkCondition
@@ -94,17 +110,77 @@ string randomString(int length = 16) {
 	return result;
 }
 
+/* Type: CountingLess
+ * ------------------------------------------------------------
+ * A comparator that orders strings with operator< and counts how many
+ * times it was called, so that the speed tests can report comparisons
+ * alongside wall time.
+ */
+long numComparisons = 0;
+
+struct CountingLess {
+    bool operator()(const string& a, const string& b) const {
+        numComparisons++;
+        return a < b;
+    }
+};
+
+/* Type: SpeedTestResult
+ * ------------------------------------------------------------
+ * The measurements taken by a single speed test.
+ */
+struct SpeedTestResult {
+    double seconds;
+    long allocations;
+    long comparisons;
+};
+
+/*
+ * Function: loadQueue
+ * ------------------------------------------------------------
+ * Move a batch of words into a queue one at a time.
+ */
+template <typename PQueue>
+void loadQueue(PQueue& queue, Vector<string>& values, bool) {
+    for (int i = 0; i < values.size(); i++)
+        queue.enqueue(std::move(values[i]));
+}
+
+/*
+ * Move a batch of words into a heap. If bulkLoad is set, the whole batch
+ *   is handed to enqueueAll() so that the heap is built in one pass.
+ */
+template <typename ValueType, typename Compare, int Arity, bool AlignToCacheLine, typename Stats>
+void loadQueue(HeapPriorityQueue<ValueType, Compare, Arity, AlignToCacheLine, Stats>& queue,
+               Vector<string>& values, bool bulkLoad) {
+    if (bulkLoad && !values.isEmpty()) {
+        string* first = &values[0];
+        queue.enqueueAll(make_move_iterator(first),
+                         make_move_iterator(first + values.size()));
+    } else {
+        for (int i = 0; i < values.size(); i++)
+            queue.enqueue(std::move(values[i]));
+    }
+}
+
 /*
  * Function: runSpeedTest
  * ------------------------------------------------------------
- * Return the number of seconds to perform nIter iterations of inserting
- *   then removing wordsPerIteration words from a queue.
+ * Time nIter iterations of inserting then removing wordsPerIteration
+ *   words from a queue. Only the queue's own work is timed, not making up
+ *   and sorting the words. Besides the number of seconds taken, record how
+ *   many heap allocations and comparisons the queue itself made. PQueue
+ *   should order its strings with CountingLess. If bulkLoad is set and the
+ *   queue supports it, the words are added all at once.
  */
 template <typename PQueue>
-   double runSpeedTests(const int nIter, const int wordsPerIteration) {
+   SpeedTestResult runSpeedTests(const int nIter, const int wordsPerIteration,
+                                 bool bulkLoad = false) {
    
-       /* Clock the execution of the program Priority Queue */
-       double beginTime = clock();
+       SpeedTestResult result;
+       result.seconds = 0;
+       result.allocations = 0;
+       result.comparisons = 0;
        
        for (int iteration = 0; iteration < nIter; iteration++) {
            Vector<string> randomValues;
@@ -119,21 +195,267 @@ template <typename PQueue>
            reverse(randomValues.begin(), randomValues.end());
            
            
-           /* Feed these values into priority queue and pull them back out. */
-           PQueue queue;
-           foreach (string value in randomValues)
-             queue.enqueue(value);
+           /* Feed these values into priority queue and pull them back out.
+            * The values are moved in, so a queue that does not copy them
+            * makes no allocations for the strings themselves.
+            */
+           long allocationsBefore = allocationCount();
+           numComparisons = 0;
+           Stopwatch stopwatch;
+           {
+               PQueue queue;
+               loadQueue(queue, randomValues, bulkLoad);
        
-           for (int i = 0; i < randomValues.size(); i++)
-               queue.dequeueMin();
-
+               for (int i = 0; i < randomValues.size(); i++)
+                   queue.dequeueMin();
+           }
+           result.seconds += stopwatch.seconds();
+           result.allocations += allocationCount() - allocationsBefore;
+           result.comparisons += numComparisons;
        }
-       
-       /* Stop the clock */
-       double endTime = clock();
-       
-       /* Compute the time difference and return it */
-       return (endTime - beginTime) / CLOCKS_PER_SEC;
+       return result;
+}
+
+/* Type: LockedPriorityQueue
+ * ------------------------------------------------------------
+ * A wrapper that lets several threads share any priority queue by holding
+ * one lock around every operation. It is the baseline that the concurrent
+ * queues are measured against.
+ */
+template <typename PQueue, typename ValueType>
+class LockedPriorityQueue {
+public:
+    void enqueue(const ValueType& value) {
+        lock_guard<mutex> guard(lock);
+        queue.enqueue(value);
+    }
+
+    bool tryDequeueMin(ValueType& result) {
+        lock_guard<mutex> guard(lock);
+        if (queue.isEmpty()) return false;
+        result = queue.dequeueMin();
+        return true;
+    }
+
+private:
+    mutex lock;
+    PQueue queue;
+};
+
+/*
+ * Function: runThreadScalingTest
+ * ------------------------------------------------------------
+ * Time numThreads threads sharing one queue of integers, each of which
+ *   alternately enqueues a random value and dequeues the smallest one. The
+ *   queue starts with a number of values in it so that the threads work on
+ *   a heap of realistic depth. Wall time is measured with steady_clock,
+ *   since clock() adds up the time of every thread.
+ */
+template <typename PQueue>
+double runThreadScalingTest(int numThreads, int operationsPerThread) {
+    const int NUM_INITIAL_VALUES = 100000;
+    PQueue queue;
+    minstd_rand random(1);
+    for (int i = 0; i < NUM_INITIAL_VALUES; i++) {
+        queue.enqueue(int(random() % 1000000));
+    }
+
+    Stopwatch stopwatch;
+    vector<thread> threads;
+    for (int t = 0; t < numThreads; t++) {
+        threads.push_back(thread([&queue, t, operationsPerThread]() {
+            minstd_rand random(t + 2);
+            int value;
+            for (int i = 0; i < operationsPerThread; i++) {
+                queue.enqueue(int(random() % 1000000));
+                queue.tryDequeueMin(value);
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); t++) {
+        threads[t].join();
+    }
+    return stopwatch.seconds();
+}
+
+/*
+ * Function: runWorkStealingTest
+ * ------------------------------------------------------------
+ * The same workload as runThreadScalingTest on a work-stealing queue,
+ *   where each thread is a worker of its own and the initial values are
+ *   spread over the workers.
+ */
+double runWorkStealingTest(int numThreads, int operationsPerThread) {
+    const int NUM_INITIAL_VALUES = 100000;
+    WorkStealingPriorityQueue<int, IntegerKey<int> > queue(numThreads);
+    minstd_rand random(1);
+    for (int i = 0; i < NUM_INITIAL_VALUES; i++) {
+        queue.enqueue(i % numThreads, int(random() % 1000000));
+    }
+
+    Stopwatch stopwatch;
+    vector<thread> threads;
+    for (int t = 0; t < numThreads; t++) {
+        threads.push_back(thread([&queue, t, operationsPerThread]() {
+            minstd_rand random(t + 2);
+            int value;
+            for (int i = 0; i < operationsPerThread; i++) {
+                queue.enqueue(t, int(random() % 1000000));
+                queue.tryDequeueMin(t, value);
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); t++) {
+        threads[t].join();
+    }
+    return stopwatch.seconds();
+}
+
+/*
+ * Function: runThreadScalingTests
+ * ------------------------------------------------------------
+ * Run the same total number of operations on 1, 2, 4 and so on up to as
+ *   many threads as the machine has cores, and print the throughput of
+ *   the concurrent heap next to a binary heap behind a single lock.
+ */
+void runThreadScalingTests() {
+    const int TOTAL_OPERATIONS = 400000;
+    int numCores = max(1, int(thread::hardware_concurrency()));
+    cout << endl << "Threads sharing one queue (" << numCores << " cores):" << endl;
+
+    for (int numThreads = 1; ; numThreads = min(numThreads * 2, numCores)) {
+        int operationsPerThread = TOTAL_OPERATIONS / numThreads;
+        double concurrentSeconds = runThreadScalingTest<ConcurrentHeapPriorityQueue<int> >
+            (numThreads, operationsPerThread);
+        double lockedSeconds = runThreadScalingTest<LockedPriorityQueue<HeapPriorityQueue<int>, int> >
+            (numThreads, operationsPerThread);
+        double multiQueueSeconds = runThreadScalingTest<MultiQueuePriorityQueue<int> >
+            (numThreads, operationsPerThread);
+        double workStealingSeconds = runWorkStealingTest(numThreads, operationsPerThread);
+        double lockFreeSeconds = runThreadScalingTest<LockFreeSkipListPriorityQueue<int> >
+            (numThreads, operationsPerThread);
+        cout << numThreads << " threads: concurrent heap "
+             << long(2 * TOTAL_OPERATIONS / concurrentSeconds) << " operations/second, "
+             << "locked heap " << long(2 * TOTAL_OPERATIONS / lockedSeconds) << " operations/second, "
+             << "MultiQueue " << long(2 * TOTAL_OPERATIONS / multiQueueSeconds) << " operations/second, "
+             << "work stealing " << long(2 * TOTAL_OPERATIONS / workStealingSeconds) << " operations/second, "
+             << "lock-free skip list " << long(2 * TOTAL_OPERATIONS / lockFreeSeconds) << " operations/second" << endl;
+        if (numThreads == numCores) break;
+    }
+}
+
+/* Type: FenwickTree
+ * ------------------------------------------------------------
+ * A binary indexed tree over the integers 0 to n - 1 that counts how
+ * many of each are present, and can count the ones below a given value
+ * in O(log n) time.
+ */
+class FenwickTree {
+public:
+    explicit FenwickTree(int n) : counts(n + 1, 0) {}
+
+    /* Changes the count of a value by delta. */
+    void add(int value, int delta) {
+        for (int i = value + 1; i < int(counts.size()); i += i & -i) {
+            counts[i] += delta;
+        }
+    }
+
+    /* Returns how many values below the given one are present. */
+    int countBelow(int value) {
+        int count = 0;
+        for (int i = value; i > 0; i -= i & -i) {
+            count += counts[i];
+        }
+        return count;
+    }
+
+private:
+    vector<int> counts;
+};
+
+/* Type: RankErrorResult
+ * ------------------------------------------------------------
+ * How far from the smallest value the values a queue hands out are.
+ */
+struct RankErrorResult {
+    double mean;
+    int max;
+};
+
+/*
+ * Function: measureRankError
+ * ------------------------------------------------------------
+ * Fill a queue with numValues distinct integers, then repeatedly dequeue
+ *   a value and enqueue a new one. The rank error of each dequeue is the
+ *   number of values still in the queue that are smaller than the value it
+ *   returned, which is 0 for an exact priority queue. The values present
+ *   are tracked in a Fenwick tree so each rank costs O(log n).
+ */
+template <typename PQueue>
+RankErrorResult measureRankError(PQueue& queue, int numValues, int numOperations) {
+    vector<int> values(numValues + numOperations);
+    for (int i = 0; i < int(values.size()); i++) {
+        values[i] = i;
+    }
+    minstd_rand random(1);
+    shuffle(values.begin(), values.end(), random);
+
+    FenwickTree present(values.size());
+    for (int i = 0; i < numValues; i++) {
+        queue.enqueue(values[i]);
+        present.add(values[i], 1);
+    }
+
+    RankErrorResult result;
+    result.max = 0;
+    long totalError = 0;
+    for (int i = 0; i < numOperations; i++) {
+        int value = queue.dequeueMin();
+        present.add(value, -1);
+        int rank = present.countBelow(value);
+        totalError += rank;
+        result.max = max(result.max, rank);
+
+        queue.enqueue(values[numValues + i]);
+        present.add(values[numValues + i], 1);
+    }
+    result.mean = double(totalError) / numOperations;
+    return result;
+}
+
+/*
+ * Function: runRankErrorTests
+ * ------------------------------------------------------------
+ * Print the rank error of the exact heap and of MultiQueues made of more
+ *   and more heaps.
+ */
+void runRankErrorTests() {
+    const int NUM_VALUES = 100000;
+    const int NUM_OPERATIONS = 100000;
+    cout << endl << "Rank error with " << NUM_VALUES << " values:" << endl;
+
+    HeapPriorityQueue<int> heap;
+    RankErrorResult result = measureRankError(heap, NUM_VALUES, NUM_OPERATIONS);
+    cout << "Heap Priority Queue: mean " << result.mean << ", max " << result.max << endl;
+
+    for (int numHeaps = 2; numHeaps <= 64; numHeaps *= 2) {
+        MultiQueuePriorityQueue<int> multiQueue(numHeaps);
+        result = measureRankError(multiQueue, NUM_VALUES, NUM_OPERATIONS);
+        cout << "MultiQueue of " << numHeaps << " heaps: mean " << result.mean
+             << ", max " << result.max << endl;
+    }
+}
+
+/*
+ * Function: printSpeedTestResult
+ * ------------------------------------------------------------
+ * Print out the measurements of one speed test.
+ */
+void printSpeedTestResult(string name, SpeedTestResult result) {
+    cout << name << ": " << result.seconds << " seconds, "
+         << result.comparisons << " comparisons, "
+         << result.allocations << " allocations" << endl;
 }
 
 /*
@@ -141,7 +463,9 @@ template <typename PQueue>
  * ------------------------------------------------------------
  * Add and then remove many words from each type of priority queue.
  *   Perform this operation multiple times and clock the total time
- *   taken. Print out this time for each priority queue.
+ *   taken. Print out this time for each priority queue. These are quick
+ *   checks at one size; the standalone benchmark in pqueue-benchmark.cpp
+ *   times each phase separately over a range of sizes.
  */
 void runSpeedTests() {
     const int NUM_ITERATIONS = 1;
@@ -150,25 +474,68 @@ void runSpeedTests() {
     //   check against memory leaks in the program
     const int WORDS_PER_ITERATION = 30000;
 
-    double vectorSpeed =
-    runSpeedTests<VectorPriorityQueue> (NUM_ITERATIONS, WORDS_PER_ITERATION);
-    cout << "Vector: " << vectorSpeed << " seconds" << endl;
+    printSpeedTestResult("Vector",
+      runSpeedTests<VectorPriorityQueue<string, CountingLess> > (NUM_ITERATIONS, WORDS_PER_ITERATION));
+
+    printSpeedTestResult("Vector (packed keys)",
+      runSpeedTests<VectorPriorityQueue<string, CountingLess, StringPrefixKey> > (NUM_ITERATIONS, WORDS_PER_ITERATION));
     
-    double linkedListSpeed =
-      runSpeedTests<LinkedListPriorityQueue> (NUM_ITERATIONS, WORDS_PER_ITERATION);
-    cout << "Linked List: " << linkedListSpeed << " seconds" << endl;
+    printSpeedTestResult("Linked List",
+      runSpeedTests<LinkedListPriorityQueue<string, CountingLess> > (NUM_ITERATIONS, WORDS_PER_ITERATION));
     
-    double dLinkedListSpeed =
-      runSpeedTests<DoublyLinkedListPriorityQueue> (NUM_ITERATIONS, WORDS_PER_ITERATION);
-    cout << "Double Linked List: " << dLinkedListSpeed << " seconds" << endl;
+    printSpeedTestResult("Double Linked List",
+      runSpeedTests<DoublyLinkedListPriorityQueue<string, CountingLess> > (NUM_ITERATIONS, WORDS_PER_ITERATION));
+
+    printSpeedTestResult("Skip List",
+      runSpeedTests<SkipListPriorityQueue<string, CountingLess> > (NUM_ITERATIONS, WORDS_PER_ITERATION));
+
+    printSpeedTestResult("Heap Priority Queue",
+      runSpeedTests<HeapPriorityQueue<string, CountingLess> > (NUM_ITERATIONS, WORDS_PER_ITERATION));
+
+    printSpeedTestResult("Radix Queue",
+      runSpeedTests<RadixPriorityQueue<string, StringPrefixKey, CountingLess> > (NUM_ITERATIONS, WORDS_PER_ITERATION));
+
+    printSpeedTestResult("Heap Priority Queue (bulk load)",
+      runSpeedTests<HeapPriorityQueue<string, CountingLess> > (NUM_ITERATIONS, WORDS_PER_ITERATION, true));
+
+    printSpeedTestResult("Heap Priority Queue (cache aligned)",
+      runSpeedTests<HeapPriorityQueue<string, CountingLess, 2, true> > (NUM_ITERATIONS, WORDS_PER_ITERATION));
+
+    printSpeedTestResult("4-ary Heap Priority Queue",
+      runSpeedTests<HeapPriorityQueue<string, CountingLess, 4> > (NUM_ITERATIONS, WORDS_PER_ITERATION));
+
+    printSpeedTestResult("4-ary Heap Priority Queue (cache aligned)",
+      runSpeedTests<HeapPriorityQueue<string, CountingLess, 4, true> > (NUM_ITERATIONS, WORDS_PER_ITERATION));
 
-    double heapPriorityQueueSpeed =
-      runSpeedTests<HeapPriorityQueue> (NUM_ITERATIONS, WORDS_PER_ITERATION);
-    cout << "Heap Priority Queue: " << heapPriorityQueueSpeed << " seconds" << endl;
+    printSpeedTestResult("8-ary Heap Priority Queue",
+      runSpeedTests<HeapPriorityQueue<string, CountingLess, 8> > (NUM_ITERATIONS, WORDS_PER_ITERATION));
     
-    double fibHeapSpeed =
-      runSpeedTests<FibonacciHeapPriorityQueue> (NUM_ITERATIONS, WORDS_PER_ITERATION);
-    cout << "Fib Heap: " << fibHeapSpeed << " seconds" << endl;
+    printSpeedTestResult("Fib Heap",
+      runSpeedTests<FibonacciHeapPriorityQueue<string, CountingLess> > (NUM_ITERATIONS, WORDS_PER_ITERATION));
+
+    printSpeedTestResult("Pairing Heap",
+      runSpeedTests<PairingHeapPriorityQueue<string, CountingLess> > (NUM_ITERATIONS, WORDS_PER_ITERATION));
+
+    // small queues are filled and drained many times over, where the
+    //   cost of each scan or sift matters more than how it grows
+    const int NUM_SMALL_ITERATIONS = 200;
+    const int WORDS_PER_SMALL_ITERATION = 500;
+    cout << endl << "Small queues of " << WORDS_PER_SMALL_ITERATION << " words:" << endl;
+
+    printSpeedTestResult("Vector",
+      runSpeedTests<VectorPriorityQueue<string, CountingLess> > (NUM_SMALL_ITERATIONS, WORDS_PER_SMALL_ITERATION));
+
+    printSpeedTestResult("Vector (packed keys)",
+      runSpeedTests<VectorPriorityQueue<string, CountingLess, StringPrefixKey> > (NUM_SMALL_ITERATIONS, WORDS_PER_SMALL_ITERATION));
+
+    printSpeedTestResult("Heap Priority Queue",
+      runSpeedTests<HeapPriorityQueue<string, CountingLess> > (NUM_SMALL_ITERATIONS, WORDS_PER_SMALL_ITERATION));
+
+    printSpeedTestResult("Radix Queue",
+      runSpeedTests<RadixPriorityQueue<string, StringPrefixKey, CountingLess> > (NUM_SMALL_ITERATIONS, WORDS_PER_SMALL_ITERATION));
+
+    runThreadScalingTests();
+    runRankErrorTests();
 }
 
 
@@ -1107,136 +1474,1701 @@ template <typename PQueue>
 	endTest("My Very Own Tests");	
 }
 
-/* Function: testPriorityQueue
+/* Function: decreaseKeyTests
  * ------------------------------------------------------------------
- * A function that runs the full battery of tests on a priority
- * queue of arbitrary type.
+ * Tests for priority queues whose enqueue() hands back a handle that
+ * can be passed to decreaseKey() and remove().  The queue's output is
+ * compared against a sorted copy of what it should contain.
  */
 template <typename PQueue>
-	void testPriorityQueue() {
+	void decreaseKeyTests() {
+	beginTest("Decrease Key Tests");
 	
-	basicStructuralTests<PQueue> ();
-	sortAscendingTests<PQueue> ();
-	sortDescendingTests<PQueue> ();
-	sortRandomTests<PQueue> ();
-	sortCraftedTests<PQueue> ();
-	sortDuplicateTests<PQueue> ();
-	reuseTests<PQueue> ();
+	try {
+		{
+			logInfo("Decreasing the largest value to become the smallest.");
+			PQueue queue;
+			queue.enqueue("B");
+			queue.enqueue("C");
+			typename PQueue::Handle handle = queue.enqueue("D");
+			queue.dequeueMin();
+			queue.decreaseKey(handle, "A");
+			checkCondition(queue.peek() == "A", "Decreased value is the new minimum.");
+			checkCondition(queue.dequeueMin() == "A", "Queue should yield A.");
+			checkCondition(queue.dequeueMin() == "C", "Queue should yield C.");
+			checkCondition(queue.isEmpty(), "Queue should be empty.");
+		}
+		
+		{
+			PQueue queue;
+			typename PQueue::Handle handle = queue.enqueue("B");
+			bool didThrow = false;
+			try {
+				queue.decreaseKey(handle, "C");
+			} catch (ErrorException&) {
+				didThrow = true;
+			}
+			checkCondition(didThrow, "Priority queue uses 'error' when decreaseKey() would increase a value.");
+		}
+		
+		{
+			logInfo("Decreasing a value through a handle from a merged queue.");
+			PQueue first;
+			PQueue second;
+			first.enqueue("C");
+			first.enqueue("D");
+			typename PQueue::Handle handle = second.enqueue("E");
+			second.enqueue("F");
+			first.merge(second);
+			first.decreaseKey(handle, "A");
+			checkCondition(first.dequeueMin() == "A", "Handle still refers to the merged value.");
+			checkCondition(first.dequeueMin() == "C", "Queue should yield C.");
+		}
+		
+		{
+			logInfo("Decreasing and removing 2000 random values between dequeues.");
+			PQueue queue;
+			Vector<string> values;
+			Vector<typename PQueue::Handle> handles;
+			for (int i = 0; i < 2000; i++) {
+				values += randomString();
+				handles += queue.enqueue(values[i]);
+			}
+			
+			/* Dequeue a few values first so that the heap has some structure
+			 * for decreaseKey() to cut apart.
+			 */
+			Vector<string> expected = values;
+			sort(expected.begin(), expected.end());
+			bool isCorrect = true;
+			for (int i = 0; i < 10; i++) {
+				if (queue.dequeueMin() != expected[i]) isCorrect = false;
+			}
+			Vector<bool> isLive(values.size(), true);
+			for (int i = 0; i < values.size(); i++) {
+				if (values[i] <= expected[9]) isLive[i] = false;
+			}
+			
+			for (int i = 0; i < values.size(); i++) {
+				if (!isLive[i]) continue;
+				if (randomChance(0.25)) {
+					queue.remove(handles[i]);
+					isLive[i] = false;
+				} else if (randomChance(0.5)) {
+					string lower = values[i].substr(0, randomInteger(0, 15));
+					queue.decreaseKey(handles[i], lower);
+					values[i] = lower;
+				}
+			}
+			
+			expected.clear();
+			for (int i = 0; i < values.size(); i++) {
+				if (isLive[i]) expected += values[i];
+			}
+			sort(expected.begin(), expected.end());
+			
+			checkCondition(queue.size() == expected.size(), "Queue has the right size after removals.");
+			for (int i = 0; i < expected.size() && isCorrect; i++) {
+				if (queue.dequeueMin() != expected[i]) isCorrect = false;
+			}
+			checkCondition(isCorrect, "Queue yields the decreased values in sorted order.");
+			checkCondition(queue.isEmpty(), "Queue should be empty.");
+		}
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
 	
-	myVeryOwnTests<PQueue> ();
-}
-
-/* Function: printReplInstructions
- * ------------------------------------------------------------------
- * Prints instructions on how to use the REPL environment.
- */
-void printReplInstructions() {
-	cout << "Interactive Priority Queue Test" << endl;
-	cout << "===============================" << endl;
-	cout << "This environment allows you to type in commands that will be" << endl;
-	cout << "executed on your priority queue.  The interpreter knows the" << endl;
-	cout << "following commands:" << endl;
-	cout << endl;
-	cout << "   isEmpty:        Reports whether the priority queue is empty." << endl;
-	cout << "   size:           Reports the size of the priority queue" << endl;
-	cout << "   enqueue <str>:  Enqueues the string <str>" << endl;
-	cout << "   peek:           Peeks at the minimum element of the priority queue." << endl;
-	cout << "   dequeueMin:     Dequeues the minimum element of the priority queue." << endl;
-	cout << "   quit:           Quits the interpret and returns to the menu." << endl;
-	cout << endl;
-	cout << "The first letter of any command can be used as a substitute" << endl;
-	cout << "for any command name." << endl;
+	endTest("Decrease Key Tests");
 }
 
-/* Function: replTestPriorityQueue
+/* Function: clearTests
  * ------------------------------------------------------------------
- * A function that executes a read/eval/print loop (REPL) that allows
- * you to manually test out the priority queue.  Entering commands
- * like
- *
- *    enqueue This is a test
- *
- * or
- *
- *    peek
- *
- * will execute those corresponding commands on the priority queue.
- * You can use this code to interactively step through your priority
- * queue.
+ * Tests that clear() empties a priority queue and leaves it ready for
+ * reuse.
  */
 template <typename PQueue>
-	void replTestPriorityQueue() {
-	printReplInstructions();
+	void clearTests() {
+	beginTest("Clear Tests");
 	
-	/* These curly braces introduce a new layer of scoping.  This ensures that if
-	 * your priority queue's destructor causes an error, the error occurs before
-	 * this function returns.
-	 */
-	{
+	try {
 		PQueue queue;
-		while (true) {
-			/* Get a command from the user. */
-			istringstream command(getLine("Enter command: "));
+		queue.clear();
+		checkCondition(queue.isEmpty(), "Clearing an empty queue leaves it empty.");
 		
-			/* Extract the action. */
-			string action;
-			command >> action >> ws;
+		logInfo("Clearing a queue holding 10000 random strings.");
+		for (int i = 0; i < 10000; i++) {
+			queue.enqueue(randomString());
+			if (i % 7 == 0) queue.dequeueMin();
+		}
+		queue.clear();
+		checkCondition(queue.isEmpty(), "Queue should be empty after clear().");
+		checkCondition(queue.size() == 0, "Queue should have size zero after clear().");
 		
-			if (!command) {
-				cout << "Please enter a command." << endl;
-			} else {
-				try {
-					if (action == "peek" || action == "p") {
-						cout << queue.peek() << endl;
-					} else if (action == "isEmpty" || action == "i") {
-						cout << boolalpha << queue.isEmpty() << endl;
-					} else if (action == "size" || action == "s") {
-						cout << queue.size() << endl;
-					} else if (action == "dequeueMin" || action == "d") {
-						cout << queue.dequeueMin() << endl;
-					} else if (action == "quit" || action == "q") {
-						cout << "Leaving test environment...   " << flush;
-						break;
-					} else if (action == "enqueue" || action == "e") {
-						string toEnqueue;
-						if (!getline(command, toEnqueue)) {
-							cout << "Must specify a string to enqueue." << endl;
-						} else {
-							queue.enqueue(toEnqueue);
-							cout << "Enqueued string \"" << toEnqueue << "\"." << endl;
-						}
-					} else {
-						cout << "Unknown command." << endl;
-					}
-				
-				} catch (ErrorException& e) {
-					cout << "ERROR: " << e.getMessage() << endl;
-				} catch (exception& e) {
-					cout << "ERROR: " << e.what() << endl;
-				} catch (...) {
-					cout << "Unknown error." << endl;
-				}
+		bool didThrow = false;
+		try {
+			queue.peek();
+		} catch (ErrorException&) {
+			didThrow = true;
+		}
+		checkCondition(didThrow, "Priority queue uses 'error' when peeking after clear().");
+		
+		logInfo("Reusing the queue after clearing it.");
+		queue.enqueue("C");
+		queue.enqueue("A");
+		queue.enqueue("B");
+		checkCondition(queue.size() == 3, "Queue should have size three.");
+		checkCondition(queue.dequeueMin() == "A", "Queue should yield A.");
+		checkCondition(queue.dequeueMin() == "B", "Queue should yield B.");
+		checkCondition(queue.dequeueMin() == "C", "Queue should yield C.");
+		
+		logInfo("Destroying a queue that still holds 10000 strings.");
+		{
+			PQueue fullQueue;
+			for (int i = 0; i < 10000; i++) {
+				fullQueue.enqueue(randomString());
+				if (i % 7 == 0) fullQueue.dequeueMin();
 			}
 		}
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
 	}
 	
-	/* If we made it here, the destructor didn't crash. */
-	cout << "success." << endl;
-	cout << endl;
+	endTest("Clear Tests");
 }
 
-/* Constants for the menu. */
-enum {
-	REPL_VECTOR = 1,
-	TEST_VECTOR,
-	REPL_LINKED_LIST,
-	TEST_LINKED_LIST,
-	REPL_DOUBLY_LINKED_LIST,
-	TEST_DOUBLY_LINKED_LIST,
-	REPL_HEAP,
+/* Function: mergeTests
+ * ------------------------------------------------------------------
+ * Tests that merge() moves every value of one priority queue into
+ * another and leaves the source empty.
+ */
+template <typename PQueue>
+	void mergeTests() {
+	beginTest("Merge Tests");
+	
+	try {
+		{
+			logInfo("Merging two queues of 1000 random strings each.");
+			PQueue first;
+			PQueue second;
+			Vector<string> expected;
+			for (int i = 0; i < 1000; i++) {
+				string value = randomString();
+				expected += value;
+				first.enqueue(value);
+				value = randomString();
+				expected += value;
+				second.enqueue(value);
+				if (i % 5 == 0) {
+					first.enqueue("");
+					first.dequeueMin();
+				}
+			}
+			first.merge(second);
+			checkCondition(second.isEmpty(), "Source queue is empty after merge().");
+			checkCondition(first.size() == 2000, "Merged queue holds every value.");
+			
+			sort(expected.begin(), expected.end());
+			bool isCorrect = true;
+			for (int i = 0; i < expected.size(); i++) {
+				if (first.dequeueMin() != expected[i]) {
+					isCorrect = false;
+					break;
+				}
+			}
+			checkCondition(isCorrect, "Merged queue yields all values in sorted order.");
+			
+			second.enqueue("B");
+			second.enqueue("A");
+			checkCondition(second.dequeueMin() == "A", "Source queue can be reused after merge().");
+		}
+		
+		{
+			logInfo("Merging into an empty queue, from an empty queue, and into itself.");
+			PQueue first;
+			PQueue second;
+			second.enqueue("C");
+			second.enqueue("A");
+			second.enqueue("B");
+			first.merge(second);
+			checkCondition(first.size() == 3 && second.isEmpty(), "Empty queue takes every value.");
+			
+			first.merge(second);
+			checkCondition(first.size() == 3, "Merging an empty queue changes nothing.");
+			
+			first.merge(first);
+			checkCondition(first.size() == 3, "Merging a queue into itself changes nothing.");
+			checkCondition(first.dequeueMin() == "A", "Queue should yield A.");
+			checkCondition(first.dequeueMin() == "B", "Queue should yield B.");
+			checkCondition(first.dequeueMin() == "C", "Queue should yield C.");
+		}
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Merge Tests");
+}
+
+/* Function: batchDequeueTests
+ * ------------------------------------------------------------------
+ * Tests that dequeueMin(k, out) hands back the k smallest values in
+ * sorted order, both on its own and mixed with other operations.
+ */
+template <typename PQueue>
+	void batchDequeueTests() {
+	beginTest("Batch Dequeue Tests");
+	
+	try {
+		{
+			logInfo("Dequeuing 1000 random strings in batches of different sizes.");
+			PQueue queue;
+			Vector<string> expected;
+			for (int i = 0; i < 1000; i++) {
+				expected += randomString();
+				queue.enqueue(expected[i]);
+			}
+			sort(expected.begin(), expected.end());
+			
+			vector<string> result;
+			queue.dequeueMin(0, back_inserter(result));
+			checkCondition(result.empty() && queue.size() == 1000, "Dequeuing zero values does nothing.");
+			
+			int batchSize = 1;
+			while (!queue.isEmpty()) {
+				queue.dequeueMin(min(batchSize, queue.size()), back_inserter(result));
+				batchSize *= 2;
+			}
+			
+			bool isCorrect = int(result.size()) == expected.size();
+			for (int i = 0; i < expected.size() && isCorrect; i++) {
+				if (result[i] != expected[i]) isCorrect = false;
+			}
+			checkCondition(isCorrect, "Batches come back in sorted order.");
+		}
+		
+		{
+			logInfo("Mixing batch dequeues with enqueues.");
+			PQueue queue;
+			queue.enqueue("D");
+			queue.enqueue("B");
+			queue.enqueue("F");
+			string batch[3];
+			queue.dequeueMin(2, batch);
+			checkCondition(batch[0] == "B" && batch[1] == "D", "First batch should be B, D.");
+			queue.enqueue("A");
+			queue.enqueue("E");
+			queue.enqueue("C");
+			string* end = queue.dequeueMin(3, batch);
+			checkCondition(end == batch + 3, "Batch dequeue returns the end of its output.");
+			checkCondition(batch[0] == "A" && batch[1] == "C" && batch[2] == "E", "Second batch should be A, C, E.");
+			checkCondition(queue.size() == 1 && queue.peek() == "F", "Queue should hold only F.");
+		}
+		
+		{
+			PQueue queue;
+			queue.enqueue("A");
+			vector<string> result;
+			bool didThrow = false;
+			try {
+				queue.dequeueMin(2, back_inserter(result));
+			} catch (ErrorException&) {
+				didThrow = true;
+			}
+			checkCondition(didThrow, "Priority queue uses 'error' when asked for more values than it holds.");
+		}
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Batch Dequeue Tests");
+}
+
+/* Function: sharedPrefixTests
+ * ------------------------------------------------------------------
+ * Tests a priority queue on strings that share long prefixes, which a
+ * queue comparing only packed string prefixes would not be able to tell
+ * apart, and on queues of every size up to a few dozen values.
+ */
+template <typename PQueue>
+	void sharedPrefixTests() {
+	beginTest("Shared Prefix Tests");
+	
+	try {
+		{
+			logInfo("Sorting 1000 strings that start with the same eight letters.");
+			PQueue queue;
+			Vector<string> expected;
+			for (int i = 0; i < 1000; i++) {
+				string value = "SAMEPREF" + randomString().substr(0, randomInteger(0, 3));
+				if (randomChance(0.1)) value = value.substr(0, randomInteger(0, 8));
+				expected += value;
+				queue.enqueue(value);
+			}
+			sort(expected.begin(), expected.end());
+			
+			bool isCorrect = true;
+			for (int i = 0; i < expected.size(); i++) {
+				if (queue.dequeueMin() != expected[i]) {
+					isCorrect = false;
+					break;
+				}
+			}
+			checkCondition(isCorrect, "Queue yields the strings in sorted order.");
+		}
+		
+		{
+			logInfo("Sorting queues holding from 1 to 40 random strings.");
+			bool isCorrect = true;
+			for (int size = 1; size <= 40; size++) {
+				PQueue queue;
+				Vector<string> expected;
+				for (int i = 0; i < size; i++) {
+					expected += randomString();
+					queue.enqueue(expected[i]);
+				}
+				sort(expected.begin(), expected.end());
+				for (int i = 0; i < size; i++) {
+					if (queue.dequeueMin() != expected[i]) isCorrect = false;
+				}
+			}
+			checkCondition(isCorrect, "Queues of every size yield their strings in sorted order.");
+		}
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Shared Prefix Tests");
+}
+
+/* Function: argminKernelTests
+ * ------------------------------------------------------------------
+ * Tests each kernel for finding the smallest packed key that the processor
+ * supports against the one comparing keys one by one, on arrays of every
+ * length up to a few dozen keys, with few distinct keys so that there are
+ * many ties, and with keys near both ends of the signed range.
+ */
+void argminKernelTests() {
+	beginTest("Argmin Kernel Tests");
+	
+	try {
+		ArgminKernel kernels[] = { ARGMIN_SSE42, ARGMIN_AVX2 };
+		for (ArgminKernel kernel : kernels) {
+			if (!isArgminKernelSupported(kernel)) {
+				logInfo(string("Skipping the ") + argminKernelName(kernel) + " kernel, which this processor lacks.");
+				continue;
+			}
+			logInfo(string("Comparing the ") + argminKernelName(kernel) + " kernel with the scalar one.");
+			ArgminKernel original = activeArgminKernel();
+			bool isCorrect = true;
+			for (int n = 1; n <= 40; n++) {
+				for (int trial = 0; trial < 50; trial++) {
+					vector<int64_t> keys(n);
+					for (int i = 0; i < n; i++) {
+						keys[i] = toSignedKey(uint64_t(randomInteger(0, 4)) << 62 | uint64_t(randomInteger(0, 3)));
+					}
+					setArgminKernel(ARGMIN_SCALAR);
+					int expected = packedArgmin(keys.data(), n);
+					setArgminKernel(kernel);
+					if (packedArgmin(keys.data(), n) != expected) isCorrect = false;
+				}
+			}
+			setArgminKernel(original);
+			checkCondition(isCorrect, "Kernel finds the first smallest key.");
+		}
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Argmin Kernel Tests");
+}
+
+/* Function: nodePoolTests
+ * ------------------------------------------------------------------
+ * Tests for priority queues that allocate their cells from a NodePool.
+ * Two queues share one pool, and a queue that is emptied and refilled
+ * should reuse its cells rather than allocate new ones.
+ */
+template <typename PQueue>
+	void nodePoolTests() {
+	beginTest("Node Pool Tests");
+	
+	try {
+		{
+			logInfo("Interleaving two queues that share a pool.");
+			typename PQueue::Pool pool;
+			PQueue first(pool);
+			Vector<string> expectedFirst;
+			{
+				PQueue second(pool);
+				Vector<string> expectedSecond;
+				for (int i = 0; i < 1000; i++) {
+					expectedFirst += randomString();
+					first.enqueue(expectedFirst[i]);
+					expectedSecond += randomString();
+					second.enqueue(expectedSecond[i]);
+					if (i % 3 == 0) {
+						second.dequeueMin();
+					}
+				}
+				checkCondition(second.size() == 666, "Second queue has the right size.");
+				checkCondition(first.memoryUsage().totalBytes()
+				               == sizeof(PQueue) + 1000 * PQueue::Pool::nodeBytes(),
+				               "A queue sharing a pool counts only its own cells.");
+			}
+			
+			/* The second queue is gone, so the first must still be intact. */
+			sort(expectedFirst.begin(), expectedFirst.end());
+			bool isCorrect = true;
+			for (int i = 0; i < expectedFirst.size(); i++) {
+				if (first.dequeueMin() != expectedFirst[i]) {
+					isCorrect = false;
+					break;
+				}
+			}
+			checkCondition(isCorrect, "First queue yields its strings in sorted order.");
+		}
+		
+		{
+			logInfo("Refilling a queue that has been emptied.");
+			PQueue queue;
+			for (int i = 0; i < 500; i++) {
+				queue.enqueue(string(1, char('A' + i % 26)));
+			}
+			while (!queue.isEmpty()) {
+				queue.dequeueMin();
+			}
+			
+			/* The strings are short enough not to allocate memory of their own. */
+			long allocationsBefore = allocationCount();
+			for (int i = 0; i < 500; i++) {
+				queue.enqueue(string(1, char('A' + i % 26)));
+			}
+			long allocations = allocationCount() - allocationsBefore;
+			checkCondition(allocations == 0, "Refilled queue reuses its cells.");
+			checkCondition(queue.peek() == "A", "Refilled queue should peek at A.");
+		}
+		
+		{
+			logInfo("Merging queues whose pools are shared with other queues.");
+			typename PQueue::Pool firstPool;
+			typename PQueue::Pool secondPool;
+			PQueue first(firstPool);
+			PQueue second(secondPool);
+			PQueue bystander(secondPool);
+			Vector<string> expected;
+			for (int i = 0; i < 500; i++) {
+				expected += randomString();
+				first.enqueue(expected[expected.size() - 1]);
+				expected += randomString();
+				second.enqueue(expected[expected.size() - 1]);
+				bystander.enqueue(randomString());
+			}
+			first.merge(second);
+			checkCondition(second.isEmpty(), "Source queue is empty after merge().");
+			
+			sort(expected.begin(), expected.end());
+			bool isCorrect = first.size() == expected.size();
+			for (int i = 0; i < expected.size() && isCorrect; i++) {
+				if (first.dequeueMin() != expected[i]) isCorrect = false;
+			}
+			checkCondition(isCorrect, "Merged queue yields all values in sorted order.");
+			checkCondition(bystander.size() == 500, "Queue sharing the source pool is untouched.");
+		}
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Node Pool Tests");
+}
+
+/* Function: concurrentTests
+ * ------------------------------------------------------------------
+ * Tests a priority queue shared by several threads: producers filling it
+ * at the same time, consumers draining it at the same time, and threads
+ * doing both at once. No value may be lost or handed out twice.
+ */
+template <typename PQueue>
+	void concurrentTests() {
+	beginTest("Concurrent Tests");
+	
+	try {
+		const int NUM_THREADS = 4;
+		const int VALUES_PER_THREAD = 5000;
+		Vector<string> values;
+		for (int i = 0; i < NUM_THREADS * VALUES_PER_THREAD; i++) {
+			values += randomString();
+		}
+		vector<string> expected(values.begin(), values.end());
+		sort(expected.begin(), expected.end());
+		
+		{
+			logInfo("Filling a queue from 4 threads, then draining it from 4 threads.");
+			PQueue queue;
+			vector<thread> threads;
+			for (int t = 0; t < NUM_THREADS; t++) {
+				threads.push_back(thread([&queue, &values, t, VALUES_PER_THREAD]() {
+					for (int i = t * VALUES_PER_THREAD; i < (t + 1) * VALUES_PER_THREAD; i++) {
+						queue.enqueue(values[i]);
+					}
+				}));
+			}
+			for (int t = 0; t < NUM_THREADS; t++) {
+				threads[t].join();
+			}
+			checkCondition(queue.size() == values.size(), "Queue holds every value.");
+			
+			/* With no enqueues going on, each consumer must see its own
+			 * values in sorted order.
+			 */
+			vector<vector<string> > dequeued(NUM_THREADS);
+			threads.clear();
+			for (int t = 0; t < NUM_THREADS; t++) {
+				threads.push_back(thread([&queue, &dequeued, t]() {
+					string value;
+					while (queue.tryDequeueMin(value)) {
+						dequeued[t].push_back(value);
+					}
+				}));
+			}
+			for (int t = 0; t < NUM_THREADS; t++) {
+				threads[t].join();
+			}
+			
+			bool isSorted = true;
+			vector<string> all;
+			for (int t = 0; t < NUM_THREADS; t++) {
+				if (!is_sorted(dequeued[t].begin(), dequeued[t].end())) isSorted = false;
+				for (size_t i = 0; i < dequeued[t].size(); i++) {
+					all.push_back(dequeued[t][i]);
+				}
+			}
+			sort(all.begin(), all.end());
+			checkCondition(isSorted, "Each consumer dequeues in sorted order.");
+			checkCondition(all == expected, "Consumers dequeue every value exactly once.");
+			checkCondition(queue.isEmpty(), "Queue should be empty.");
+		}
+		
+		{
+			logInfo("Enqueuing and dequeuing from 4 threads at once.");
+			PQueue queue;
+			vector<vector<string> > dequeued(NUM_THREADS);
+			vector<thread> threads;
+			for (int t = 0; t < NUM_THREADS; t++) {
+				threads.push_back(thread([&queue, &values, &dequeued, t, VALUES_PER_THREAD]() {
+					string value;
+					for (int i = t * VALUES_PER_THREAD; i < (t + 1) * VALUES_PER_THREAD; i++) {
+						queue.enqueue(values[i]);
+						if (i % 2 == 1 && queue.tryDequeueMin(value)) {
+							dequeued[t].push_back(value);
+						}
+					}
+				}));
+			}
+			for (int t = 0; t < NUM_THREADS; t++) {
+				threads[t].join();
+			}
+			
+			vector<string> all;
+			for (int t = 0; t < NUM_THREADS; t++) {
+				for (size_t i = 0; i < dequeued[t].size(); i++) {
+					all.push_back(dequeued[t][i]);
+				}
+			}
+			checkCondition(int(all.size()) == values.size() / 2, "Every dequeue found a value.");
+			checkCondition(queue.size() == values.size() / 2, "Queue holds the values not dequeued.");
+			
+			/* Whatever is left must come out in order, and together with
+			 * what was dequeued must be exactly the values enqueued.
+			 */
+			bool isSorted = true;
+			string previous;
+			while (!queue.isEmpty()) {
+				string value = queue.dequeueMin();
+				if (value < previous) isSorted = false;
+				previous = value;
+				all.push_back(value);
+			}
+			sort(all.begin(), all.end());
+			checkCondition(isSorted, "Remaining values come out in sorted order.");
+			checkCondition(all == expected, "No value was lost or duplicated.");
+		}
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Concurrent Tests");
+}
+
+/* Function: stressTests
+ * ------------------------------------------------------------------
+ * Tests a priority queue under heavy contention: producers enqueue
+ * distinct integers while consumers dequeue at the same time, often from
+ * a nearly empty queue, until every integer has come out. Each integer
+ * must be dequeued exactly once.
+ */
+template <typename PQueue>
+	void stressTests() {
+	beginTest("Stress Tests");
+	
+	try {
+		const int NUM_PRODUCERS = 4;
+		const int NUM_CONSUMERS = 4;
+		const int VALUES_PER_PRODUCER = 50000;
+		const int NUM_VALUES = NUM_PRODUCERS * VALUES_PER_PRODUCER;
+		
+		for (int round = 0; round < 3; round++) {
+			logInfo("Producing and consuming 200000 integers from 8 threads at once.");
+			PQueue queue;
+			atomic<int> numDequeued(0);
+			vector<vector<int> > dequeued(NUM_CONSUMERS);
+			vector<thread> threads;
+			for (int t = 0; t < NUM_PRODUCERS; t++) {
+				threads.push_back(thread([&queue, t, NUM_PRODUCERS, VALUES_PER_PRODUCER]() {
+					/* Interleave the producers' values, so that they all
+					 * insert near the front of the queue at once.
+					 */
+					for (int i = 0; i < VALUES_PER_PRODUCER; i++) {
+						queue.enqueue(i * NUM_PRODUCERS + t);
+					}
+				}));
+			}
+			for (int t = 0; t < NUM_CONSUMERS; t++) {
+				threads.push_back(thread([&queue, &numDequeued, &dequeued, t, NUM_VALUES]() {
+					int value;
+					while (numDequeued.load() < NUM_VALUES) {
+						if (queue.tryDequeueMin(value)) {
+							dequeued[t].push_back(value);
+							numDequeued++;
+						} else {
+							this_thread::yield();
+						}
+					}
+				}));
+			}
+			for (size_t t = 0; t < threads.size(); t++) {
+				threads[t].join();
+			}
+			
+			vector<int> timesDequeued(NUM_VALUES, 0);
+			bool isInRange = true;
+			for (int t = 0; t < NUM_CONSUMERS; t++) {
+				for (size_t i = 0; i < dequeued[t].size(); i++) {
+					int value = dequeued[t][i];
+					if (value < 0 || value >= NUM_VALUES) {
+						isInRange = false;
+					} else {
+						timesDequeued[value]++;
+					}
+				}
+			}
+			checkCondition(isInRange, "Every dequeued value was enqueued.");
+			checkCondition(count(timesDequeued.begin(), timesDequeued.end(), 1) == NUM_VALUES,
+			               "Every value was dequeued exactly once.");
+			checkCondition(queue.isEmpty(), "Queue should be empty.");
+		}
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Stress Tests");
+}
+
+/* Function: levelGrowthTests
+ * ------------------------------------------------------------------
+ * Tests a priority queue that grows while values are being dequeued.
+ * Each queue starts with 2^k - 1 values, a full binary heap, so that the
+ * first enqueues running alongside the dequeues add a new level. Once
+ * the threads are done, the values left must come out in sorted order
+ * and none may be lost or duplicated.
+ */
+template <typename PQueue>
+	void levelGrowthTests() {
+	beginTest("Level Growth Tests");
+	
+	try {
+		const int NUM_PRODUCERS = 2;
+		const int NUM_CONSUMERS = 2;
+		const int VALUES_PER_PRODUCER = 8;
+		const int DEQUEUES_PER_CONSUMER = 4;
+		const int NUM_ROUNDS = 200;
+		
+		logInfo("Enqueuing and dequeuing from queues of 2^k - 1 values, for k = 2 to 10.");
+		bool isSorted = true;
+		bool isComplete = true;
+		for (int k = 2; k <= 10; k++) {
+			const int NUM_INITIAL = (1 << k) - 1;
+			for (int round = 0; round < NUM_ROUNDS; round++) {
+				/* The initial values are all larger than the enqueued ones,
+				 * so every enqueue sifts its value towards the root.
+				 */
+				PQueue queue;
+				for (int i = 0; i < NUM_INITIAL; i++) {
+					queue.enqueue(NUM_PRODUCERS * VALUES_PER_PRODUCER + i);
+				}
+				
+				vector<int> dequeued;
+				mutex dequeuedLock;
+				vector<thread> threads;
+				for (int t = 0; t < NUM_CONSUMERS; t++) {
+					threads.push_back(thread([&queue, &dequeued, &dequeuedLock, DEQUEUES_PER_CONSUMER]() {
+						int value;
+						for (int i = 0; i < DEQUEUES_PER_CONSUMER; i++) {
+							if (queue.tryDequeueMin(value)) {
+								lock_guard<mutex> guard(dequeuedLock);
+								dequeued.push_back(value);
+							}
+						}
+					}));
+				}
+				for (int t = 0; t < NUM_PRODUCERS; t++) {
+					threads.push_back(thread([&queue, t, NUM_PRODUCERS, VALUES_PER_PRODUCER]() {
+						for (int i = VALUES_PER_PRODUCER - 1; i >= 0; i--) {
+							queue.enqueue(i * NUM_PRODUCERS + t);
+						}
+					}));
+				}
+				for (size_t t = 0; t < threads.size(); t++) {
+					threads[t].join();
+				}
+				
+				int previous = -1;
+				while (!queue.isEmpty()) {
+					int value = queue.dequeueMin();
+					if (value < previous) isSorted = false;
+					previous = value;
+					dequeued.push_back(value);
+				}
+				
+				const int NUM_VALUES = NUM_INITIAL + NUM_PRODUCERS * VALUES_PER_PRODUCER;
+				sort(dequeued.begin(), dequeued.end());
+				if (int(dequeued.size()) != NUM_VALUES) {
+					isComplete = false;
+				} else {
+					for (int i = 0; i < NUM_VALUES; i++) {
+						if (dequeued[i] != i) isComplete = false;
+					}
+				}
+			}
+		}
+		checkCondition(isSorted, "Values left after the threads finish come out in sorted order.");
+		checkCondition(isComplete, "No value was lost or duplicated.");
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Level Growth Tests");
+}
+
+/* Function: churnPeakAllocations
+ * ------------------------------------------------------------------
+ * Fills a priority queue with initial values, then has several threads
+ * enqueue and dequeue in pairs, so that the queue stays at the same size.
+ * Returns the largest number of live allocations above the filled queue
+ * that a monitor thread saw while they ran.
+ */
+template <typename PQueue>
+	long churnPeakAllocations(int numInitial, int numThreads, int pairsPerThread) {
+	PQueue queue;
+	for (int i = 0; i < numInitial; i++) {
+		queue.enqueue(randomInteger(0, 1000000));
+	}
+	
+	long baseline = liveAllocationCount();
+	long peak = baseline;
+	atomic<bool> isDone(false);
+	thread monitor([&isDone, &peak]() {
+		while (!isDone.load()) {
+			peak = max(peak, liveAllocationCount());
+			this_thread::sleep_for(chrono::microseconds(100));
+		}
+	});
+	
+	vector<thread> threads;
+	for (int t = 0; t < numThreads; t++) {
+		threads.push_back(thread([&queue, t, pairsPerThread]() {
+			minstd_rand random(t + 1);
+			int value;
+			for (int i = 0; i < pairsPerThread; i++) {
+				queue.enqueue(int(random() % 1000000));
+				queue.tryDequeueMin(value);
+			}
+		}));
+	}
+	for (int t = 0; t < numThreads; t++) {
+		threads[t].join();
+	}
+	isDone = true;
+	monitor.join();
+	return peak - baseline;
+}
+
+/* Function: churnMemoryTests
+ * ------------------------------------------------------------------
+ * Tests that a priority queue shared by several threads does not hold on
+ * to memory under sustained churn. How much memory deleted values take
+ * before they are freed depends on how the threads are scheduled, but it
+ * must not grow with the number of operations: a run four times as long
+ * must not come close to twice the peak.
+ */
+template <typename PQueue>
+	void churnMemoryTests() {
+	beginTest("Churn Memory Tests");
+	
+	try {
+		const int NUM_THREADS = 4;
+		const int NUM_INITIAL = 1000;
+		const int SHORT_PAIRS = 250000;
+		const int LONG_PAIRS = 4 * SHORT_PAIRS;
+		
+		logInfo("Enqueuing and dequeuing 250000 times per thread from 4 threads around 1000 values.");
+		long shortPeak = churnPeakAllocations<PQueue>(NUM_INITIAL, NUM_THREADS, SHORT_PAIRS);
+		logInfo("Enqueuing and dequeuing 1000000 times per thread from 4 threads around 1000 values.");
+		long longPeak = churnPeakAllocations<PQueue>(NUM_INITIAL, NUM_THREADS, LONG_PAIRS);
+		checkCondition(longPeak <= 2 * shortPeak + 10 * NUM_INITIAL,
+		               "Peak live allocations do not grow with the number of operations.");
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Churn Memory Tests");
+}
+
+/* Function: multiQueueTests
+ * ------------------------------------------------------------------
+ * Tests for the relaxed MultiQueuePriorityQueue. Since it only hands back
+ * values close to the smallest, the usual battery does not apply; instead
+ * it must be exact with a single heap, lose no values with many, and keep
+ * its rank error small.
+ */
+void multiQueueTests() {
+	beginTest("MultiQueue Tests");
+	
+	try {
+		{
+			logInfo("A MultiQueue of one heap is exact.");
+			MultiQueuePriorityQueue<string> queue(1);
+			Vector<string> expected;
+			for (int i = 0; i < 1000; i++) {
+				expected += randomString();
+				queue.enqueue(expected[i]);
+			}
+			sort(expected.begin(), expected.end());
+			checkCondition(queue.peek() == expected[0], "Queue should peek at the smallest value.");
+			bool isCorrect = true;
+			for (int i = 0; i < expected.size(); i++) {
+				if (queue.dequeueMin() != expected[i]) {
+					isCorrect = false;
+					break;
+				}
+			}
+			checkCondition(isCorrect, "Queue yields the values in sorted order.");
+			checkCondition(queue.isEmpty(), "Queue should be empty.");
+		}
+		
+		{
+			logInfo("Dequeuing 10000 values from a MultiQueue of 8 heaps.");
+			MultiQueuePriorityQueue<string> queue(8);
+			vector<string> expected;
+			for (int i = 0; i < 10000; i++) {
+				expected.push_back(randomString());
+				queue.enqueue(expected[i]);
+			}
+			checkCondition(queue.size() == 10000, "Queue holds every value.");
+			vector<string> dequeued;
+			queue.dequeueMin(queue.size(), back_inserter(dequeued));
+			sort(expected.begin(), expected.end());
+			sort(dequeued.begin(), dequeued.end());
+			checkCondition(dequeued == expected, "Queue yields every value exactly once.");
+			
+			bool didThrow = false;
+			try {
+				queue.dequeueMin();
+			} catch (ErrorException&) {
+				didThrow = true;
+			}
+			checkCondition(didThrow, "Priority queue uses 'error' when dequeuing an empty queue.");
+		}
+		
+		{
+			logInfo("Measuring the rank error of a MultiQueue of 8 heaps.");
+			MultiQueuePriorityQueue<int> queue(8);
+			RankErrorResult result = measureRankError(queue, 10000, 10000);
+			checkCondition(result.mean < 8 * 4, "Mean rank error is a small multiple of the number of heaps.");
+			
+			MultiQueuePriorityQueue<int> exact(1);
+			result = measureRankError(exact, 10000, 10000);
+			checkCondition(result.max == 0, "A single heap has no rank error.");
+		}
+		
+		{
+			logInfo("Enqueuing and dequeuing from 4 threads at once.");
+			const int NUM_THREADS = 4;
+			const int VALUES_PER_THREAD = 5000;
+			vector<string> values;
+			for (int i = 0; i < NUM_THREADS * VALUES_PER_THREAD; i++) {
+				values.push_back(randomString());
+			}
+			MultiQueuePriorityQueue<string> queue(2 * NUM_THREADS);
+			vector<vector<string> > dequeued(NUM_THREADS);
+			vector<thread> threads;
+			for (int t = 0; t < NUM_THREADS; t++) {
+				threads.push_back(thread([&queue, &values, &dequeued, t, VALUES_PER_THREAD]() {
+					string value;
+					for (int i = t * VALUES_PER_THREAD; i < (t + 1) * VALUES_PER_THREAD; i++) {
+						queue.enqueue(values[i]);
+						if (i % 2 == 1 && queue.tryDequeueMin(value)) {
+							dequeued[t].push_back(value);
+						}
+					}
+				}));
+			}
+			for (int t = 0; t < NUM_THREADS; t++) {
+				threads[t].join();
+			}
+			
+			vector<string> all;
+			for (int t = 0; t < NUM_THREADS; t++) {
+				all.insert(all.end(), dequeued[t].begin(), dequeued[t].end());
+			}
+			string value;
+			while (queue.tryDequeueMin(value)) {
+				all.push_back(value);
+			}
+			sort(all.begin(), all.end());
+			sort(values.begin(), values.end());
+			checkCondition(all == values, "No value was lost or duplicated.");
+		}
+		
+		{
+			logInfo("Gathering the stats of a MultiQueue and its heaps.");
+			MultiQueuePriorityQueue<int, less<int>, CountingStats> queue(4);
+			for (int i = 0; i < 1000; i++) {
+				queue.enqueue(randomInteger(0, 1000));
+			}
+			while (!queue.isEmpty()) {
+				queue.dequeueMin();
+			}
+			CountingStats stats = queue.stats();
+			checkCondition(stats.comparisons() > 0, "Comparisons inside the heaps are counted.");
+			checkCondition(stats.latency(STATS_ENQUEUE).count() == 1000 &&
+			               stats.latency(STATS_DEQUEUE).count() == 1000,
+			               "Each operation is timed once, by the MultiQueue rather than its heaps.");
+		}
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("MultiQueue Tests");
+}
+
+/* Function: workStealingTests
+ * ------------------------------------------------------------------
+ * Tests for the WorkStealingPriorityQueue: each worker sees its own values
+ * in order, workers with nothing to do or a stale minimum steal from the
+ * others, and no value is lost when many threads work at once.
+ */
+void workStealingTests() {
+	beginTest("Work Stealing Tests");
+	
+	try {
+		typedef WorkStealingPriorityQueue<string, StringPrefixKey> Queue;
+		
+		{
+			logInfo("A single worker dequeues its own values in order.");
+			Queue queue(1);
+			Vector<string> expected;
+			for (int i = 0; i < 1000; i++) {
+				expected += randomString();
+				queue.enqueue(0, expected[i]);
+			}
+			sort(expected.begin(), expected.end());
+			bool isCorrect = true;
+			for (int i = 0; i < expected.size(); i++) {
+				if (queue.dequeueMin(0) != expected[i]) {
+					isCorrect = false;
+					break;
+				}
+			}
+			checkCondition(isCorrect, "Worker yields its values in sorted order.");
+			checkCondition(queue.isEmpty(), "Queue should be empty.");
+			checkCondition(queue.globalLowerBound() == Queue::EMPTY_KEY, "Empty queue publishes no key.");
+		}
+		
+		{
+			logInfo("Workers steal when they are empty or stale.");
+			Queue queue(2);
+			queue.enqueue(0, "MMMMMMMMMM");
+			queue.enqueue(0, "NNNNNNNNNN");
+			queue.enqueue(1, "AAAAAAAAAA");
+			queue.enqueue(1, "BBBBBBBBBB");
+			queue.enqueue(1, "ZZZZZZZZZZ");
+			checkCondition(queue.globalLowerBound() == StringPrefixKey::key("AAAAAAAAAA"),
+			               "Lower bound is the smallest key of any worker.");
+			checkCondition(queue.isStale(0), "Worker 0 knows worker 1 has a smaller value.");
+			checkCondition(!queue.isStale(1), "Worker 1 holds the smallest value.");
+			checkCondition(queue.dequeueMin(0) == "AAAAAAAAAA", "Stale worker steals the smallest value.");
+			checkCondition(queue.dequeueMin(0) == "BBBBBBBBBB", "Stale worker steals the better values.");
+			checkCondition(queue.dequeueMin(0) == "MMMMMMMMMM", "Worker goes back to its own values.");
+			checkCondition(queue.dequeueMin(1) == "NNNNNNNNNN", "Worker 1 steals the smaller value back.");
+			checkCondition(queue.dequeueMin(0) == "ZZZZZZZZZZ", "Empty worker steals the last value.");
+			checkCondition(queue.isEmpty(), "Queue should be empty.");
+			
+			string value;
+			checkCondition(!queue.tryDequeueMin(1, value), "Dequeuing from an empty queue fails.");
+		}
+		
+		{
+			logInfo("One producer feeding 4 consumers that only steal.");
+			const int NUM_THREADS = 4;
+			const int NUM_VALUES = 20000;
+			vector<string> values;
+			for (int i = 0; i < NUM_VALUES; i++) {
+				values.push_back(randomString());
+			}
+			Queue queue(NUM_THREADS + 1);
+			vector<vector<string> > dequeued(NUM_THREADS);
+			atomic<bool> isProducing(true);
+			vector<thread> threads;
+			threads.push_back(thread([&queue, &values, &isProducing]() {
+				for (size_t i = 0; i < values.size(); i++) {
+					queue.enqueue(0, values[i]);
+				}
+				isProducing = false;
+			}));
+			for (int t = 0; t < NUM_THREADS; t++) {
+				threads.push_back(thread([&queue, &dequeued, &isProducing, t]() {
+					string value;
+					while (true) {
+						bool wasProducing = isProducing;
+						if (queue.tryDequeueMin(t + 1, value)) {
+							dequeued[t].push_back(value);
+						} else if (!wasProducing) {
+							break;
+						}
+					}
+				}));
+			}
+			for (size_t t = 0; t < threads.size(); t++) {
+				threads[t].join();
+			}
+			
+			vector<string> all;
+			for (int t = 0; t < NUM_THREADS; t++) {
+				all.insert(all.end(), dequeued[t].begin(), dequeued[t].end());
+			}
+			sort(all.begin(), all.end());
+			sort(values.begin(), values.end());
+			checkCondition(all == values, "Consumers dequeue every value exactly once.");
+			checkCondition(queue.isEmpty(), "Queue should be empty.");
+		}
+		
+		{
+			logInfo("Adding up the memory of every worker's heap.");
+			Queue queue(4);
+			for (int i = 0; i < 1000; i++) {
+				queue.enqueue(i % 4, randomString());
+			}
+			MemoryUsage usage = queue.memoryUsage();
+			checkCondition(usage.payloadBytes == 1000 * sizeof(string), "Payload is the strings held by all workers.");
+			checkCondition(usage.overheadBytes >= sizeof(Queue), "Overhead includes the queue object.");
+		}
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Work Stealing Tests");
+}
+
+/* Function: sortedIterationTests
+ * ------------------------------------------------------------------
+ * Tests for priority queues that keep their values sorted, and so can
+ * be iterated in order and have a range of values removed at once.
+ */
+template <typename PQueue>
+	void sortedIterationTests() {
+	beginTest("Sorted Iteration Tests");
+	
+	try {
+		logInfo("Iterating over 5000 random strings.");
+		PQueue queue;
+		Vector<string> expected;
+		for (int i = 0; i < 5000; i++) {
+			expected += randomString(4);
+			queue.enqueue(expected[i]);
+		}
+		sort(expected.begin(), expected.end());
+		
+		int index = 0;
+		bool isCorrect = true;
+		for (typename PQueue::const_iterator itr = queue.begin(); itr != queue.end(); ++itr) {
+			if (index >= expected.size() || *itr != expected[index]) isCorrect = false;
+			index++;
+		}
+		checkCondition(isCorrect && index == expected.size(), "Iteration visits the strings in sorted order.");
+		
+		logInfo("Removing every string from \"F\" up to \"M\".");
+		int numRemoved = queue.removeRange("F", "M");
+		Vector<string> remaining;
+		foreach (string value in expected) {
+			if (value < "F" || value >= "M") remaining += value;
+		}
+		checkCondition(numRemoved == expected.size() - remaining.size(), "removeRange() reports how many strings it removed.");
+		checkCondition(queue.size() == remaining.size(), "Queue has the right size after removeRange().");
+		checkCondition(queue.removeRange("G", "H") == 0, "Removing an empty range removes nothing.");
+		
+		logInfo("Removing the smallest strings with removeRange().");
+		int numSmall = 0;
+		foreach (string value in remaining) {
+			if (value < "C") numSmall++;
+		}
+		checkCondition(queue.removeRange("", "C") == numSmall, "removeRange() can remove from the front.");
+		checkCondition(queue.isEmpty() || queue.peek() >= "C", "Queue no longer holds strings below C.");
+		
+		isCorrect = true;
+		for (int i = numSmall; i < remaining.size(); i++) {
+			if (queue.dequeueMin() != remaining[i]) {
+				isCorrect = false;
+				break;
+			}
+		}
+		checkCondition(isCorrect, "Queue yields the remaining strings in sorted order.");
+		checkCondition(queue.isEmpty(), "Queue should be empty.");
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Sorted Iteration Tests");
+}
+
+/* Function: bulkLoadTests
+ * ------------------------------------------------------------------
+ * Tests for priority queues that can be built from a range of values
+ * with a constructor or enqueueAll(), and that support reserve().
+ */
+template <typename PQueue>
+	void bulkLoadTests() {
+	beginTest("Bulk Load Tests");
+	
+	try {
+		{
+			logInfo("Building a queue from 5000 random strings.");
+			Vector<string> randomValues;
+			for (int i = 0; i < 5000; i++) {
+				randomValues += randomString();
+			}
+			PQueue queue(randomValues.begin(), randomValues.end());
+			checkCondition(queue.size() == randomValues.size(), "Queue holds every value in the range.");
+			
+			sort(randomValues.begin(), randomValues.end());
+			bool isCorrect = true;
+			for (int i = 0; i < randomValues.size(); i++) {
+				if (queue.dequeueMin() != randomValues[i]) {
+					isCorrect = false;
+					break;
+				}
+			}
+			checkCondition(isCorrect, "Queue yields the strings in sorted order.");
+			checkCondition(queue.isEmpty(), "Queue should be empty.");
+		}
+		
+		{
+			logInfo("Adding ranges of different sizes to a queue that is not empty.");
+			PQueue queue;
+			Vector<string> expected;
+			for (int round = 0; round < 6; round++) {
+				vector<string> batch;
+				int batchSize = (round % 2 == 0) ? 3 : 1000;
+				for (int i = 0; i < batchSize; i++) {
+					batch.push_back(randomString());
+					expected += batch.back();
+				}
+				queue.enqueueAll(make_move_iterator(batch.begin()),
+				                 make_move_iterator(batch.end()));
+			}
+			checkCondition(queue.size() == expected.size(), "Queue holds every value added.");
+			
+			sort(expected.begin(), expected.end());
+			bool isCorrect = true;
+			for (int i = 0; i < expected.size(); i++) {
+				if (queue.dequeueMin() != expected[i]) {
+					isCorrect = false;
+					break;
+				}
+			}
+			checkCondition(isCorrect, "Queue yields the strings in sorted order.");
+		}
+		
+		{
+			logInfo("Adding a range that can only be read once.");
+			istringstream input("d b e a c");
+			PQueue queue;
+			queue.enqueue("b");
+			queue.enqueueAll(istream_iterator<string>(input), istream_iterator<string>());
+			checkCondition(queue.size() == 6, "Queue holds every value read.");
+			checkCondition(queue.dequeueMin() == "a", "Queue should yield a.");
+			checkCondition(queue.dequeueMin() == "b", "Queue should yield b.");
+			checkCondition(queue.dequeueMin() == "b", "Queue should yield b.");
+			checkCondition(queue.dequeueMin() == "c", "Queue should yield c.");
+		}
+		
+		{
+			logInfo("Reserving room before enqueuing 1000 values.");
+			PQueue queue;
+			queue.reserve(1000);
+			checkCondition(queue.isEmpty(), "Reserving room does not add values.");
+			for (int i = 999; i >= 0; i--) {
+				queue.enqueue(integerToString(10000 + i));
+			}
+			bool isCorrect = true;
+			for (int i = 0; i < 1000; i++) {
+				if (queue.dequeueMin() != integerToString(10000 + i)) {
+					isCorrect = false;
+					break;
+				}
+			}
+			checkCondition(isCorrect, "Queue yields the values in sorted order.");
+		}
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Bulk Load Tests");
+}
+
+/* Function: monotoneTests
+ * ------------------------------------------------------------------
+ * Tests a priority queue of integers used the way Dijkstra's algorithm
+ * or an event simulation uses one: every value enqueued is at least the
+ * last value dequeued.
+ */
+template <typename PQueue>
+	void monotoneTests() {
+	beginTest("Monotone Tests");
+	
+	try {
+		logInfo("Running 20000 steps of a simulation with 1000 pending events.");
+		PQueue queue;
+		for (int i = 0; i < 1000; i++) {
+			queue.enqueue(randomInteger(0, 1000));
+		}
+		bool isCorrect = true;
+		int last = 0;
+		for (int i = 0; i < 20000; i++) {
+			int time = queue.dequeueMin();
+			if (time < last) isCorrect = false;
+			last = time;
+			queue.enqueue(time + randomInteger(0, 1000));
+		}
+		checkCondition(isCorrect, "Events come out in time order.");
+		checkCondition(queue.size() == 1000, "Queue keeps the same number of events.");
+		
+		logInfo("Enqueuing a value below the last one dequeued.");
+		queue.enqueue(last - 5);
+		checkCondition(queue.dequeueMin() == last - 5, "Lower value comes out first.");
+		checkCondition(queue.dequeueMin() >= last, "Remaining values are still in order.");
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Monotone Tests");
+}
+
+/* Function: customComparatorTests
+ * ------------------------------------------------------------------
+ * Tests a priority queue holding integers and ordered by greater<int>,
+ * so that it hands back the largest value first.  This checks that the
+ * queue only relies on its comparator rather than on operator<.
+ */
+template <typename PQueue>
+	void customComparatorTests() {
+	beginTest("Custom Comparator Tests");
+	
+	try {
+		logInfo("Enqueuing 1000 random integers into a max-first queue.");
+		Vector<int> randomValues;
+		PQueue queue;
+		for (int i = 0; i < 1000; i++) {
+			randomValues += randomInteger(-1000, 1000);
+			queue.enqueue(randomValues[i]);
+		}
+		
+		sort(randomValues.begin(), randomValues.end(), greater<int>());
+		
+		checkCondition(queue.peek() == randomValues[0], "Queue should peek at the largest value.");
+		bool isCorrect = true;
+		for (int i = 0; i < randomValues.size(); i++) {
+			if (queue.dequeueMin() != randomValues[i]) {
+				isCorrect = false;
+				break;
+			}
+		}
+		checkCondition(isCorrect, "Queue yields integers from largest to smallest.");
+		checkCondition(queue.isEmpty(), "Queue should be empty.");
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Custom Comparator Tests");
+}
+
+/* Function: statsTests
+ * ------------------------------------------------------------------
+ * Tests a priority queue of integers that keeps CountingStats. Its
+ * comparisons should be counted and every enqueue and dequeueMin timed,
+ * without changing the order in which the values come out.
+ */
+template <typename PQueue>
+	void statsTests() {
+	beginTest("Stats Tests");
+	
+	try {
+		logInfo("Enqueuing and dequeuing 1000 random integers.");
+		Vector<int> randomValues;
+		PQueue queue;
+		for (int i = 0; i < 1000; i++) {
+			randomValues += randomInteger(0, 100);
+			queue.enqueue(randomValues[i]);
+		}
+		sort(randomValues.begin(), randomValues.end());
+		bool isCorrect = true;
+		for (int i = 0; i < randomValues.size(); i++) {
+			if (queue.dequeueMin() != randomValues[i]) {
+				isCorrect = false;
+			}
+		}
+		checkCondition(isCorrect, "Queue yields the integers in sorted order.");
+		
+		CountingStats stats(queue.stats());
+		checkCondition(stats.comparisons() > 0, "Comparisons are counted.");
+		const LatencyHistogram& enqueues = stats.latency(STATS_ENQUEUE);
+		const LatencyHistogram& dequeues = stats.latency(STATS_DEQUEUE);
+		checkCondition(enqueues.count() == 1000, "Every enqueue is timed.");
+		checkCondition(dequeues.count() == 1000, "Every dequeueMin is timed.");
+		checkCondition(dequeues.percentile(50) <= dequeues.percentile(99),
+		               "The median latency is no larger than the 99th percentile.");
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Stats Tests");
+}
+
+/* Function: heapStatsTests
+ * ------------------------------------------------------------------
+ * Tests the counts that only the heaps keep: the moves and resizes of
+ * the binary heap, and the consolidate passes and links of the
+ * Fibonacci heap. Also checks that a queue without stats is no larger
+ * for having a stats policy, and that the latency histogram places its
+ * values to within its precision.
+ */
+void heapStatsTests() {
+	beginTest("Heap Stats Tests");
+	
+	try {
+		logInfo("Growing a binary heap past its initial capacity.");
+		HeapPriorityQueue<int, less<int>, 2, false, CountingStats> heap;
+		for (int i = 1000; i > 0; i--) {
+			heap.enqueue(i);
+		}
+		checkCondition(heap.stats().resizes() > 0, "Growing the storage counts as a resize.");
+		checkCondition(heap.stats().moves() > 0, "Sifting values up counts moves.");
+		
+		logInfo("Dequeuing from a Fibonacci heap.");
+		FibonacciHeapPriorityQueue<int, less<int>, CountingStats> fibonacci;
+		for (int i = 0; i < 100; i++) {
+			fibonacci.enqueue(randomInteger(0, 1000));
+		}
+		checkCondition(fibonacci.stats().consolidations() == 0, "Enqueues do not consolidate.");
+		fibonacci.dequeueMin();
+		checkCondition(fibonacci.stats().consolidations() == 1, "A dequeueMin consolidates once.");
+		checkCondition(fibonacci.stats().links() == 99 - 4,
+		               "Consolidating 99 single-cell trees leaves one tree for each of the 4 bits set in 99.");
+		
+		logInfo("Checking the size of queues without stats.");
+		checkCondition(sizeof(HeapPriorityQueue<int>) < sizeof(HeapPriorityQueue<int, less<int>, 2, false, CountingStats>),
+		               "CountingStats makes a heap larger.");
+		checkCondition(is_empty<NoStats>::value, "NoStats takes no space as a base class.");
+		
+		logInfo("Recording latencies into a histogram.");
+		LatencyHistogram histogram;
+		for (int i = 1; i <= 1000; i++) {
+			histogram.record(i * 1000);
+		}
+		long long median = histogram.percentile(50);
+		checkCondition(histogram.count() == 1000, "Histogram counts every latency.");
+		checkCondition(median >= 500000 && median <= 500000 * 17 / 16,
+		               "Median is within the histogram's precision.");
+		checkCondition(histogram.percentile(100) >= 1000000, "Largest latency is covered.");
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Heap Stats Tests");
+}
+
+/* Function: memoryUsageTests
+ * ------------------------------------------------------------------
+ * Tests the memory a priority queue of integers reports. Its payload
+ * should be exactly the integers it holds, and its overhead at least the
+ * queue object itself.
+ */
+template <typename PQueue>
+	void memoryUsageTests() {
+	beginTest("Memory Usage Tests");
+	
+	try {
+		PQueue queue;
+		MemoryUsage empty = queue.memoryUsage();
+		checkCondition(empty.payloadBytes == 0, "Empty queue has no payload.");
+		checkCondition(empty.overheadBytes >= sizeof(PQueue), "Overhead includes the queue object.");
+		
+		logInfo("Enqueuing 1000 integers.");
+		for (int i = 0; i < 1000; i++) {
+			queue.enqueue(randomInteger(0, 1000));
+		}
+		MemoryUsage full = queue.memoryUsage();
+		checkCondition(full.payloadBytes == 1000 * sizeof(int), "Payload is the integers held.");
+		checkCondition(full.totalBytes() > empty.totalBytes(), "Queue takes more memory as it grows.");
+		checkCondition(full.totalBytes() == full.payloadBytes + full.overheadBytes,
+		               "Total is payload plus overhead.");
+		
+		logInfo("Dequeuing every integer.");
+		while (!queue.isEmpty()) {
+			queue.dequeueMin();
+		}
+		checkCondition(queue.memoryUsage().payloadBytes == 0, "Emptied queue has no payload.");
+	} catch (ErrorException& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.getMessage() << endl;
+	} catch (exception& e) {
+		cout << "TEST FAILURE: Unexpected exception: " << e.what() << endl;
+	} catch (...) {
+		cout << "TEST FAILURE: Unknown exception." << endl;
+	}
+	
+	endTest("Memory Usage Tests");
+}
+
+/* Function: testPriorityQueue
+ * ------------------------------------------------------------------
+ * A function that runs the full battery of tests on a priority
+ * queue of arbitrary type.
+ */
+template <typename PQueue>
+	void testPriorityQueue() {
+	
+	basicStructuralTests<PQueue> ();
+	sortAscendingTests<PQueue> ();
+	sortDescendingTests<PQueue> ();
+	sortRandomTests<PQueue> ();
+	sortCraftedTests<PQueue> ();
+	sortDuplicateTests<PQueue> ();
+	reuseTests<PQueue> ();
+	batchDequeueTests<PQueue> ();
+	clearTests<PQueue> ();
+	mergeTests<PQueue> ();
+	
+	myVeryOwnTests<PQueue> ();
+}
+
+/* Function: printReplInstructions
+ * ------------------------------------------------------------------
+ * Prints instructions on how to use the REPL environment.
+ */
+void printReplInstructions() {
+	cout << "Interactive Priority Queue Test" << endl;
+	cout << "===============================" << endl;
+	cout << "This environment allows you to type in commands that will be" << endl;
+	cout << "executed on your priority queue.  The interpreter knows the" << endl;
+	cout << "following commands:" << endl;
+	cout << endl;
+	cout << "   isEmpty:        Reports whether the priority queue is empty." << endl;
+	cout << "   size:           Reports the size of the priority queue" << endl;
+	cout << "   enqueue <str>:  Enqueues the string <str>" << endl;
+	cout << "   peek:           Peeks at the minimum element of the priority queue." << endl;
+	cout << "   dequeueMin:     Dequeues the minimum element of the priority queue." << endl;
+	cout << "   quit:           Quits the interpret and returns to the menu." << endl;
+	cout << endl;
+	cout << "The first letter of any command can be used as a substitute" << endl;
+	cout << "for any command name." << endl;
+}
+
+/* Function: replTestPriorityQueue
+ * ------------------------------------------------------------------
+ * A function that executes a read/eval/print loop (REPL) that allows
+ * you to manually test out the priority queue.  Entering commands
+ * like
+ *
+ *    enqueue This is a test
+ *
+ * or
+ *
+ *    peek
+ *
+ * will execute those corresponding commands on the priority queue.
+ * You can use this code to interactively step through your priority
+ * queue.
+ */
+template <typename PQueue>
+	void replTestPriorityQueue() {
+	printReplInstructions();
+	
+	/* These curly braces introduce a new layer of scoping.  This ensures that if
+	 * your priority queue's destructor causes an error, the error occurs before
+	 * this function returns.
+	 */
+	{
+		PQueue queue;
+		while (true) {
+			/* Get a command from the user. */
+			istringstream command(getLine("Enter command: "));
+		
+			/* Extract the action. */
+			string action;
+			command >> action >> ws;
+		
+			if (!command) {
+				cout << "Please enter a command." << endl;
+			} else {
+				try {
+					if (action == "peek" || action == "p") {
+						cout << queue.peek() << endl;
+					} else if (action == "isEmpty" || action == "i") {
+						cout << boolalpha << queue.isEmpty() << endl;
+					} else if (action == "size" || action == "s") {
+						cout << queue.size() << endl;
+					} else if (action == "dequeueMin" || action == "d") {
+						cout << queue.dequeueMin() << endl;
+					} else if (action == "quit" || action == "q") {
+						cout << "Leaving test environment...   " << flush;
+						break;
+					} else if (action == "enqueue" || action == "e") {
+						string toEnqueue;
+						if (!getline(command, toEnqueue)) {
+							cout << "Must specify a string to enqueue." << endl;
+						} else {
+							queue.enqueue(toEnqueue);
+							cout << "Enqueued string \"" << toEnqueue << "\"." << endl;
+						}
+					} else {
+						cout << "Unknown command." << endl;
+					}
+				
+				} catch (ErrorException& e) {
+					cout << "ERROR: " << e.getMessage() << endl;
+				} catch (exception& e) {
+					cout << "ERROR: " << e.what() << endl;
+				} catch (...) {
+					cout << "Unknown error." << endl;
+				}
+			}
+		}
+	}
+	
+	/* If we made it here, the destructor didn't crash. */
+	cout << "success." << endl;
+	cout << endl;
+}
+
+/* Constants for the menu. */
+enum {
+	REPL_VECTOR = 1,
+	TEST_VECTOR,
+	REPL_LINKED_LIST,
+	TEST_LINKED_LIST,
+	REPL_DOUBLY_LINKED_LIST,
+	TEST_DOUBLY_LINKED_LIST,
+	REPL_HEAP,
 	TEST_HEAP,
 	REPL_FIBONACCI,
 	TEST_FIBONACCI,
+	REPL_SKIP_LIST,
+	TEST_SKIP_LIST,
+	REPL_PAIRING_HEAP,
+	TEST_PAIRING_HEAP,
+	REPL_RADIX,
+	TEST_RADIX,
+	REPL_CONCURRENT_HEAP,
+	TEST_CONCURRENT_HEAP,
+	REPL_MULTIQUEUE,
+	TEST_MULTIQUEUE,
+	TEST_WORK_STEALING,
+	REPL_LOCK_FREE_SKIP_LIST,
+	TEST_LOCK_FREE_SKIP_LIST,
     SPEED_TEST,
 	QUIT
 };
@@ -1258,6 +3190,19 @@ void displayMenu() {
 	cout << TEST_HEAP << ": Automatically test HeapPriorityQueue" << endl;
 	cout << REPL_FIBONACCI << ": Manually test FibonacciHeapPriorityQueue" << endl;
 	cout << TEST_FIBONACCI << ": Automatically test FibonacciHeapPriorityQueue" << endl;
+	cout << REPL_SKIP_LIST << ": Manually test SkipListPriorityQueue" << endl;
+	cout << TEST_SKIP_LIST << ": Automatically test SkipListPriorityQueue" << endl;
+	cout << REPL_PAIRING_HEAP << ": Manually test PairingHeapPriorityQueue" << endl;
+	cout << TEST_PAIRING_HEAP << ": Automatically test PairingHeapPriorityQueue" << endl;
+	cout << REPL_RADIX << ": Manually test RadixPriorityQueue" << endl;
+	cout << TEST_RADIX << ": Automatically test RadixPriorityQueue" << endl;
+	cout << REPL_CONCURRENT_HEAP << ": Manually test ConcurrentHeapPriorityQueue" << endl;
+	cout << TEST_CONCURRENT_HEAP << ": Automatically test ConcurrentHeapPriorityQueue" << endl;
+	cout << REPL_MULTIQUEUE << ": Manually test MultiQueuePriorityQueue" << endl;
+	cout << TEST_MULTIQUEUE << ": Automatically test MultiQueuePriorityQueue" << endl;
+	cout << TEST_WORK_STEALING << ": Automatically test WorkStealingPriorityQueue" << endl;
+	cout << REPL_LOCK_FREE_SKIP_LIST << ": Manually test LockFreeSkipListPriorityQueue" << endl;
+	cout << TEST_LOCK_FREE_SKIP_LIST << ": Automatically test LockFreeSkipListPriorityQueue" << endl;
     cout << SPEED_TEST << ": Test speeds of various queue implementations (takes a while)" << endl;
 	cout << QUIT << ": Quit" << endl;
 }
@@ -1272,34 +3217,142 @@ int main() {
 		/* Respond to the user's choice. */
 		switch (getInteger("Enter choice: ")) {
 		case TEST_VECTOR:
-			testPriorityQueue<VectorPriorityQueue> ();
+			testPriorityQueue<VectorPriorityQueue<string> > ();
+			customComparatorTests<VectorPriorityQueue<int, greater<int> > > ();
+			
+			/* Also run the battery on a vector with packed keys, once with
+			 * each kernel for finding the smallest key that the processor
+			 * supports.
+			 */
+			argminKernelTests();
+			for (ArgminKernel kernel : { ARGMIN_SCALAR, ARGMIN_SSE42, ARGMIN_AVX2 }) {
+				ArgminKernel original = activeArgminKernel();
+				if (!setArgminKernel(kernel)) continue;
+				cout << "Using the " << argminKernelName(kernel) << " kernel for packed keys." << endl;
+				testPriorityQueue<VectorPriorityQueue<string, less<string>, StringPrefixKey> > ();
+				sharedPrefixTests<VectorPriorityQueue<string, less<string>, StringPrefixKey> > ();
+				customComparatorTests<VectorPriorityQueue<int, greater<int>, ReverseKey<IntegerKey<int> > > > ();
+				setArgminKernel(original);
+			}
+			statsTests<VectorPriorityQueue<int, less<int>, NoPackedKeys, CountingStats> > ();
+			memoryUsageTests<VectorPriorityQueue<int> > ();
 			break;
 		case REPL_VECTOR:
-			replTestPriorityQueue<VectorPriorityQueue> ();
+			replTestPriorityQueue<VectorPriorityQueue<string> > ();
 			break;
 		case TEST_LINKED_LIST:
-			testPriorityQueue<LinkedListPriorityQueue> ();
+			testPriorityQueue<LinkedListPriorityQueue<string> > ();
+			customComparatorTests<LinkedListPriorityQueue<int, greater<int> > > ();
+			nodePoolTests<LinkedListPriorityQueue<string> > ();
+			statsTests<LinkedListPriorityQueue<int, less<int>, CountingStats> > ();
+			memoryUsageTests<LinkedListPriorityQueue<int> > ();
 			break;
 		case REPL_LINKED_LIST:
-			replTestPriorityQueue<LinkedListPriorityQueue> ();
+			replTestPriorityQueue<LinkedListPriorityQueue<string> > ();
 			break;
 		case TEST_DOUBLY_LINKED_LIST:
-			testPriorityQueue<DoublyLinkedListPriorityQueue> ();
+			testPriorityQueue<DoublyLinkedListPriorityQueue<string> > ();
+			customComparatorTests<DoublyLinkedListPriorityQueue<int, greater<int> > > ();
+			nodePoolTests<DoublyLinkedListPriorityQueue<string> > ();
+			statsTests<DoublyLinkedListPriorityQueue<int, less<int>, CountingStats> > ();
+			memoryUsageTests<DoublyLinkedListPriorityQueue<int> > ();
 			break;
 		case REPL_DOUBLY_LINKED_LIST:
-			replTestPriorityQueue<DoublyLinkedListPriorityQueue> ();
+			replTestPriorityQueue<DoublyLinkedListPriorityQueue<string> > ();
 			break;			
 		case TEST_HEAP:
-			testPriorityQueue<HeapPriorityQueue> ();
+			testPriorityQueue<HeapPriorityQueue<string> > ();
+			customComparatorTests<HeapPriorityQueue<int, greater<int> > > ();
+			bulkLoadTests<HeapPriorityQueue<string> > ();
+			
+			/* Also run the battery on a cache-aligned 4-ary heap. */
+			testPriorityQueue<HeapPriorityQueue<string, less<string>, 4, true> > ();
+			bulkLoadTests<HeapPriorityQueue<string, less<string>, 4, true> > ();
+			customComparatorTests<HeapPriorityQueue<int, greater<int>, 8> > ();
+			statsTests<HeapPriorityQueue<int, less<int>, 4, false, CountingStats> > ();
+			memoryUsageTests<HeapPriorityQueue<int, less<int>, 4, true> > ();
+			heapStatsTests();
 			break;
 		case REPL_HEAP:
-			replTestPriorityQueue<HeapPriorityQueue> ();
+			replTestPriorityQueue<HeapPriorityQueue<string> > ();
 			break;
 		case TEST_FIBONACCI:
-			testPriorityQueue<FibonacciHeapPriorityQueue> ();
+			testPriorityQueue<FibonacciHeapPriorityQueue<string> > ();
+			customComparatorTests<FibonacciHeapPriorityQueue<int, greater<int> > > ();
+			nodePoolTests<FibonacciHeapPriorityQueue<string> > ();
+			decreaseKeyTests<FibonacciHeapPriorityQueue<string> > ();
+			statsTests<FibonacciHeapPriorityQueue<int, less<int>, CountingStats> > ();
+			memoryUsageTests<FibonacciHeapPriorityQueue<int> > ();
 			break;
 		case REPL_FIBONACCI:
-			replTestPriorityQueue<FibonacciHeapPriorityQueue> ();
+			replTestPriorityQueue<FibonacciHeapPriorityQueue<string> > ();
+			break;
+		case TEST_SKIP_LIST:
+			testPriorityQueue<SkipListPriorityQueue<string> > ();
+			customComparatorTests<SkipListPriorityQueue<int, greater<int> > > ();
+			sortedIterationTests<SkipListPriorityQueue<string> > ();
+			statsTests<SkipListPriorityQueue<int, less<int>, CountingStats> > ();
+			memoryUsageTests<SkipListPriorityQueue<int> > ();
+			break;
+		case REPL_SKIP_LIST:
+			replTestPriorityQueue<SkipListPriorityQueue<string> > ();
+			break;
+		case TEST_PAIRING_HEAP:
+			testPriorityQueue<PairingHeapPriorityQueue<string> > ();
+			customComparatorTests<PairingHeapPriorityQueue<int, greater<int> > > ();
+			nodePoolTests<PairingHeapPriorityQueue<string> > ();
+			decreaseKeyTests<PairingHeapPriorityQueue<string> > ();
+			statsTests<PairingHeapPriorityQueue<int, less<int>, CountingStats> > ();
+			memoryUsageTests<PairingHeapPriorityQueue<int> > ();
+			break;
+		case REPL_PAIRING_HEAP:
+			replTestPriorityQueue<PairingHeapPriorityQueue<string> > ();
+			break;
+		case TEST_RADIX:
+			testPriorityQueue<RadixPriorityQueue<string, StringPrefixKey> > ();
+			sharedPrefixTests<RadixPriorityQueue<string, StringPrefixKey> > ();
+			customComparatorTests<RadixPriorityQueue<int, ReverseKey<IntegerKey<int> >, greater<int> > > ();
+			monotoneTests<RadixPriorityQueue<int, IntegerKey<int> > > ();
+			statsTests<RadixPriorityQueue<int, IntegerKey<int>, less<int>, CountingStats> > ();
+			memoryUsageTests<RadixPriorityQueue<int, IntegerKey<int> > > ();
+			break;
+		case REPL_RADIX:
+			replTestPriorityQueue<RadixPriorityQueue<string, StringPrefixKey> > ();
+			break;
+		case TEST_CONCURRENT_HEAP:
+			testPriorityQueue<ConcurrentHeapPriorityQueue<string> > ();
+			customComparatorTests<ConcurrentHeapPriorityQueue<int, greater<int> > > ();
+			concurrentTests<ConcurrentHeapPriorityQueue<string> > ();
+			stressTests<ConcurrentHeapPriorityQueue<int> > ();
+			levelGrowthTests<ConcurrentHeapPriorityQueue<int> > ();
+			statsTests<ConcurrentHeapPriorityQueue<int, less<int>, CountingStats> > ();
+			memoryUsageTests<ConcurrentHeapPriorityQueue<int> > ();
+			break;
+		case REPL_CONCURRENT_HEAP:
+			replTestPriorityQueue<ConcurrentHeapPriorityQueue<string> > ();
+			break;
+		case TEST_MULTIQUEUE:
+			multiQueueTests();
+			memoryUsageTests<MultiQueuePriorityQueue<int> > ();
+			break;
+		case REPL_MULTIQUEUE:
+			replTestPriorityQueue<MultiQueuePriorityQueue<string> > ();
+			break;
+		case TEST_WORK_STEALING:
+			workStealingTests();
+			break;
+		case TEST_LOCK_FREE_SKIP_LIST:
+			testPriorityQueue<LockFreeSkipListPriorityQueue<string> > ();
+			customComparatorTests<LockFreeSkipListPriorityQueue<int, greater<int> > > ();
+			concurrentTests<LockFreeSkipListPriorityQueue<string> > ();
+			stressTests<LockFreeSkipListPriorityQueue<int> > ();
+			levelGrowthTests<LockFreeSkipListPriorityQueue<int> > ();
+			churnMemoryTests<LockFreeSkipListPriorityQueue<int> > ();
+			statsTests<LockFreeSkipListPriorityQueue<int, less<int>, CountingStats> > ();
+			memoryUsageTests<LockFreeSkipListPriorityQueue<int> > ();
+			break;
+		case REPL_LOCK_FREE_SKIP_LIST:
+			replTestPriorityQueue<LockFreeSkipListPriorityQueue<string> > ();
 			break;
         case SPEED_TEST:
             runSpeedTests();
@@ -9,38 +9,380 @@
 #define PQueue_Vector_Included
 
 #include <string>
-#include "vector.h"
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include "pqueue-packedkeys.h"
+#include "error.h"
+#include "pqueue-stats.h"
+#include "pqueue-memoryusage.h"
 using namespace std;
 
-/* A class representing a priority queue backed by an unsorted Vector.
+/* A class representing a priority queue backed by an unsorted vector.
+ * Values are ordered by Compare, which defaults to operator<.
+ *
+ * The index of the smallest value is cached, so peek() is O(1) and
+ * enqueue() keeps it up to date with a single comparison. Removing a value
+ * fills its slot with the last value rather than shifting the rest down,
+ * and the smallest value is only searched for again the next time it is
+ * needed.
+ *
+ * KeyTraits can switch on packed keys (see pqueue-packedkeys.h). A 64-bit
+ * key is then kept for every value next to the values themselves, and the
+ * search for the smallest value compares the keys, several at a time where
+ * the processor allows it, and only calls the comparator on ties. This
+ * makes small queues of short strings or integers very fast to scan.
+ *
+ * Stats is a stats policy from pqueue-stats.h. Only calls to the
+ * comparator count as comparisons, so with packed keys the count shows how
+ * many ties the keys left for the comparator to settle.
  */
-class VectorPriorityQueue {
-  public:	
+template <typename ValueType, typename Compare = less<ValueType>,
+          typename KeyTraits = NoPackedKeys, typename Stats = NoStats>
+class VectorPriorityQueue : private Stats {
+  public:
+	/* Constructs a new, empty priority queue ordered by the given comparator. */
+	explicit VectorPriorityQueue(Compare compare = Compare());
+
 	/* Returns the number of elements in the priority queue. */
 	int size();
-	
+
 	/* Returns whether or not the priority queue is empty. */
 	bool isEmpty();
-	
-	/* Enqueues a new string into the priority queue. */
-	void enqueue(string value);
-	
-	/* Returns, but does not remove, the lexicographically first string in the
-	 * priority queue.
+
+	/* Enqueues a copy of a value into the priority queue. */
+	void enqueue(const ValueType& value);
+
+	/* Enqueues a value into the priority queue, moving it into storage. */
+	void enqueue(ValueType&& value);
+
+	/* Enqueues a value constructed in place from the given arguments. */
+	template <typename... Args>
+	void emplace(Args&&... args);
+
+	/* Returns, but does not remove, the first value in the priority queue. */
+	const ValueType& peek();
+
+	/* Returns and removes the first value in the priority queue. */
+	ValueType dequeueMin();
+
+	/* Removes the k smallest values from the priority queue and writes them
+	 * to out in sorted order. Returns the output iterator one past the last
+	 * value written.
+	 */
+	template <typename OutputIterator>
+	OutputIterator dequeueMin(int k, OutputIterator out);
+
+	/* Removes every value from the priority queue. */
+	void clear();
+
+	/* Moves every value of other into this priority queue, leaving other
+	 * empty. No value is copied.
 	 */
-	string peek();
-	
-	/* Returns and removes the lexicographically first string in the
-	 * priority queue.
+	void merge(VectorPriorityQueue& other);
+
+	/* Returns the stats the queue has kept so far. */
+	const Stats& stats();
+
+	/* Returns the bytes the queue takes, split into the values and the
+	 * overhead of the spare capacity and of the packed keys, if any.
 	 */
-	string dequeueMin();
+	MemoryUsage memoryUsage();
 
   private:
-    // vector to store queue elements
-    Vector<string> storage;
+    // vector to store queue elements; a std::vector rather than the
+    //   Stanford Vector so that elements can be moved in and out
+    vector<ValueType> storage;
+
+    // comparator deciding which of two values comes first
+    Compare isLess;
+
+    // compare two values, counting the comparison
+    bool lessThan(const ValueType& a, const ValueType& b);
+
+    // packed keys of the elements, in the same order as storage; only
+    //   used if KeyTraits::IS_PACKED is set
+    vector<int64_t> keys;
+
+    // whether the element at one index comes before the one at another,
+    //   comparing their keys first if there are any
+    bool isLessAt(int first, int second);
+
+    // recompute the keys after the elements have been rearranged
+    void rebuildKeys();
+
+    // index of the smallest element, or NO_MIN_INDEX if it is not known
+    //   and has to be searched for
+    int minIndex;
+    static const int NO_MIN_INDEX = -1;
 
     // get the index number of the smallest element
     int getSmallestIndex();
 };
 
+/*************************************************************
+ * Implementation of the VectorPriorityQueue class. Since the class is a
+ * template, the implementation has to be visible in the header.
+ */
+
+/*
+ * Constructor to store the comparator.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::VectorPriorityQueue(Compare compare)
+    : isLess(compare) {
+    minIndex = NO_MIN_INDEX;
+}
+
+/*
+ * Return the current size of the queue.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+int VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::size() {
+	return storage.size();
+}
+
+/*
+ * Return whether the queue is empty.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+bool VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::isEmpty() {
+	return (storage.size() == 0);
+}
+
+/*
+ * Add a copy of a value to the end of the queue.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+void VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::enqueue(const ValueType& value) {
+    emplace(value);
+}
+
+/*
+ * Add a value to the end of the queue without copying it.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+void VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::enqueue(ValueType&& value) {
+    emplace(std::move(value));
+}
+
+/*
+ * Construct a value directly at the end of the queue, and remember its
+ *   index if it is the new smallest element.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+template <typename... Args>
+void VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::emplace(Args&&... args) {
+    typename Stats::Timer timer(*this, STATS_ENQUEUE);
+    if (storage.size() == storage.capacity()) {
+        Stats::countResize();
+        Stats::countMoves(storage.size());
+    }
+    storage.emplace_back(std::forward<Args>(args)...);
+    if (KeyTraits::IS_PACKED) {
+        keys.push_back(toSignedKey(KeyTraits::key(storage.back())));
+    }
+    int newIndex = storage.size() - 1;
+    if (newIndex == 0) {
+        minIndex = 0;
+    } else if (minIndex != NO_MIN_INDEX && isLessAt(newIndex, minIndex)) {
+        minIndex = newIndex;
+    }
+}
+
+/*
+ * Look at the value of the next element to be dequeued.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+const ValueType& VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::peek() {
+    if (isEmpty()) error("The queue is empty");
+
+    int smallestIndex = getSmallestIndex();
+    return storage[smallestIndex];
+}
+
+/*
+ * Remove and return the smallest element in the queue. The last element
+ *   is moved into its slot, since the order of the vector does not matter.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+ValueType VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::dequeueMin() {
+    typename Stats::Timer timer(*this, STATS_DEQUEUE);
+    if (isEmpty()) error("The queue is empty");
+
+    int smallestIndex = getSmallestIndex();
+    ValueType val = std::move(storage[smallestIndex]);
+    if (smallestIndex != int(storage.size()) - 1) {
+        storage[smallestIndex] = std::move(storage.back());
+        Stats::countMoves(1);
+    }
+    storage.pop_back();
+    if (KeyTraits::IS_PACKED) {
+        keys[smallestIndex] = keys.back();
+        keys.pop_back();
+    }
+    minIndex = NO_MIN_INDEX;
+    return val;
+}
+
+/*
+ * Remove the k smallest elements from the queue. Rather than scanning the
+ *   vector once per element, the k smallest are selected into the front
+ *   of the vector in linear time, sorted and moved out. The holes they
+ *   leave are filled from the end of the vector.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+template <typename OutputIterator>
+OutputIterator VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::dequeueMin(int k, OutputIterator out) {
+    if (k < 0 || k > size()) error("Cannot dequeue more values than the queue holds");
+
+    auto countedLess = [this](const ValueType& a, const ValueType& b) {
+        return lessThan(a, b);
+    };
+    typename vector<ValueType>::iterator middle = storage.begin() + k;
+    if (middle != storage.end()) {
+        nth_element(storage.begin(), middle, storage.end(), countedLess);
+    }
+    sort(storage.begin(), middle, countedLess);
+    out = std::move(storage.begin(), middle, out);
+
+    int remaining = storage.size() - k;
+    int numToMove = min(k, remaining);
+    std::move(storage.end() - numToMove, storage.end(), storage.begin());
+    Stats::countMoves(numToMove);
+    storage.erase(storage.end() - k, storage.end());
+    if (KeyTraits::IS_PACKED) {
+        rebuildKeys();
+    }
+    minIndex = NO_MIN_INDEX;
+    return out;
+}
+
+/*
+ * Remove every element from the queue.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+void VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::clear() {
+    storage.clear();
+    keys.clear();
+    minIndex = NO_MIN_INDEX;
+}
+
+/*
+ * Merge another queue into this one by moving its values onto the end of
+ *   the vector. The smallest value stays known if it was known in both.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+void VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::merge(VectorPriorityQueue& other) {
+    if (&other == this || other.isEmpty()) return;
+
+    int offset = storage.size();
+    int otherMinIndex = other.minIndex;
+    if (storage.size() + other.storage.size() > storage.capacity()) {
+        Stats::countResize();
+        Stats::countMoves(storage.size());
+    }
+    storage.reserve(storage.size() + other.storage.size());
+    std::move(other.storage.begin(), other.storage.end(), back_inserter(storage));
+    if (KeyTraits::IS_PACKED) {
+        keys.insert(keys.end(), other.keys.begin(), other.keys.end());
+    }
+
+    if (offset == 0) {
+        minIndex = otherMinIndex;
+    } else if (minIndex == NO_MIN_INDEX || otherMinIndex == NO_MIN_INDEX) {
+        minIndex = NO_MIN_INDEX;
+    } else if (isLessAt(offset + otherMinIndex, minIndex)) {
+        minIndex = offset + otherMinIndex;
+    }
+    other.clear();
+}
+
+/*
+ * Get the index number of the smallest element in the queue, searching
+ *   for it only if it is not already known.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+int VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::getSmallestIndex() {
+    if (isEmpty()) error("The queue is empty");
+    if (minIndex != NO_MIN_INDEX) return minIndex;
+    int smallestIndex = 0;
+
+    if (KeyTraits::IS_PACKED) {
+        // find the smallest key, then let the comparator decide between
+        //   the values that share it
+        smallestIndex = packedArgmin(keys.data(), keys.size());
+        int64_t smallestKey = keys[smallestIndex];
+        for (int i = smallestIndex + 1; i < int(keys.size()); i++) {
+            if (keys[i] == smallestKey && lessThan(storage[i], storage[smallestIndex])) {
+                smallestIndex = i;
+            }
+        }
+    } else {
+        // traverse the list and continually check whether the next cell
+        //   is smaller than the currently smallest cell
+        for (int i = 0; i < int(storage.size()); i++) {
+            if (lessThan(storage[i], storage[smallestIndex])) {
+                smallestIndex = i;
+            }
+        }
+    }
+    minIndex = smallestIndex;
+    return smallestIndex;
+}
+
+/*
+ * Compare the elements at two indices. Different keys settle the order
+ *   without calling the comparator.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+bool VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::isLessAt(int first, int second) {
+    if (KeyTraits::IS_PACKED && keys[first] != keys[second]) {
+        return keys[first] < keys[second];
+    }
+    return lessThan(storage[first], storage[second]);
+}
+
+/*
+ * Compare two values with the comparator, counting the comparison in the
+ *   stats.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+bool VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::lessThan(const ValueType& a,
+                                                                         const ValueType& b) {
+    Stats::countComparison();
+    return isLess(a, b);
+}
+
+/*
+ * Return the stats kept so far.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+const Stats& VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::stats() {
+    return *this;
+}
+
+/*
+ * Count the capacity of the vectors rather than their size.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+MemoryUsage VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::memoryUsage() {
+    size_t totalBytes = sizeof(*this) + storage.capacity() * sizeof(ValueType)
+                        + keys.capacity() * sizeof(int64_t);
+    return MemoryUsage(storage.size() * sizeof(ValueType), totalBytes);
+}
+
+/*
+ * Recompute the key of every element.
+ */
+template <typename ValueType, typename Compare, typename KeyTraits, typename Stats>
+void VectorPriorityQueue<ValueType, Compare, KeyTraits, Stats>::rebuildKeys() {
+    keys.clear();
+    for (int i = 0; i < int(storage.size()); i++) {
+        keys.push_back(toSignedKey(KeyTraits::key(storage[i])));
+    }
+}
+
 #endif
@@ -0,0 +1,371 @@
+/**********************************************
+ * File: pqueue-workload.h
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * Workloads that mix enqueues and dequeues the way real programs do, for
+ * the benchmark in pqueue-benchmark.cpp. Every workload is a template over
+ * the queue type, so each implementation runs exactly the same operations.
+ *
+ * The hold model is the classic benchmark for event schedulers: a queue
+ * of fixed size in which each step dequeues the smallest value and
+ * enqueues it again with a random increment added, as a simulation does
+ * when an event schedules the next one. Dijkstra's algorithm gives a
+ * monotone pattern whose queue grows and shrinks with the frontier of the
+ * search. Finally, any sequence of operations can be recorded into a
+ * trace, stored in a compact binary file, and replayed against every
+ * queue.
+ *
+ * Workload values are long longs. Dijkstra's algorithm packs a distance
+ * and a vertex into one value, so that queues of plain integers can run it.
+ */
+#ifndef PQueue_Workload_Included
+#define PQueue_Workload_Included
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <random>
+#include <cstdint>
+#include "pqueue-benchmark.h"
+#include "error.h"
+using namespace std;
+
+/* Type: TraceOperation
+ * One step of a recorded workload: either an enqueue of value, or a
+ * dequeueMin, whose value is not recorded.
+ */
+struct TraceOperation {
+	bool isEnqueue;
+	long long value;
+};
+
+/* Type: Trace
+ * A recorded sequence of queue operations.
+ */
+typedef vector<TraceOperation> Trace;
+
+/* Type: RandomGraph
+ * A directed graph with random edge weights, stored as adjacency arrays:
+ * the edges leaving vertex v are those from firstEdge[v] up to
+ * firstEdge[v + 1].
+ */
+struct RandomGraph {
+	vector<int> firstEdge;
+	vector<int> target;
+	vector<int> weight;
+
+	/* Returns the number of vertices in the graph. */
+	int numVertices() const {
+		return int(firstEdge.size()) - 1;
+	}
+};
+
+/* A priority queue adapter that forwards every operation to another queue
+ * and records it in a trace.
+ */
+template <typename PQueue>
+class TraceRecorder {
+public:
+	/* Creates a recorder for queue that appends to trace. */
+	TraceRecorder(PQueue& queue, Trace& trace) : queue(queue), trace(trace) {}
+
+	/* Returns the number of elements in the recorded queue. */
+	int size() {
+		return queue.size();
+	}
+
+	/* Returns whether or not the recorded queue is empty. */
+	bool isEmpty() {
+		return queue.isEmpty();
+	}
+
+	/* Enqueues a value and records the enqueue. */
+	void enqueue(long long value) {
+		TraceOperation operation = { true, value };
+		trace.push_back(operation);
+		queue.enqueue(value);
+	}
+
+	/* Dequeues the smallest value and records the dequeue. */
+	long long dequeueMin() {
+		TraceOperation operation = { false, 0 };
+		trace.push_back(operation);
+		return queue.dequeueMin();
+	}
+
+private:
+	PQueue& queue;
+	Trace& trace;
+};
+
+/* Function: writeTrace
+ * Writes a trace to a binary stream. The stream holds the four bytes
+ * "PQTR", the number of operations, and then one record per operation.
+ * Every number is written as a variable-length integer of seven bits per
+ * byte. A dequeue is the single byte 0; an enqueue is stored as one more
+ * than the difference from the previously enqueued value, since
+ * consecutive values in a workload tend to be close.
+ */
+void writeTrace(ostream& out, const Trace& trace);
+
+/* Function: readTrace
+ * Reads a trace written by writeTrace. Reports an error if the stream
+ * does not hold a trace, or if the trace ever dequeues from an empty
+ * queue, so that replaying it cannot fail part way through.
+ */
+Trace readTrace(istream& in);
+
+/* Function: peakSize
+ * Returns the largest number of values a trace holds in the queue at once.
+ */
+int peakSize(const Trace& trace);
+
+/* Function: makeRandomGraph
+ * Returns a random graph on numVertices vertices in which each vertex has
+ * degree edges to random vertices with weights from 1 to maxWeight. A path
+ * through every vertex in turn is included, so that all vertices can be
+ * reached from vertex 0.
+ */
+RandomGraph makeRandomGraph(int numVertices, int degree, int maxWeight, unsigned seed);
+
+/* Function: runHoldModel
+ * Fills an empty queue with size values, then times numOperations hold
+ * steps, each a dequeueMin followed by an enqueue, and returns the seconds
+ * taken. Filling the queue and drawing the random numbers is not timed.
+ */
+template <typename PQueue>
+double runHoldModel(PQueue& queue, int size, int numOperations, unsigned seed);
+
+/* Function: runDijkstra
+ * Times Dijkstra's algorithm from vertex 0 of graph on an empty queue, and
+ * returns the seconds taken. Rather than decrease the key of a vertex, it
+ * enqueues a new entry for it and skips entries that are out of date when
+ * they are dequeued. This finds the right distances even with the relaxed
+ * queues, which then simply make more operations. The number of queue
+ * operations is stored in numOperations and the sum of the distances in
+ * checksum, so that results can be compared across queues.
+ */
+template <typename PQueue>
+double runDijkstra(PQueue& queue, const RandomGraph& graph, long& numOperations, long long& checksum);
+
+/* Function: replayTrace
+ * Times the operations of a trace on an empty queue and returns the
+ * seconds taken.
+ */
+template <typename PQueue>
+double replayTrace(PQueue& queue, const Trace& trace);
+
+/*************************************************************
+ * Implementation of the workloads. The non-template functions are inline
+ * so that the header can be included in more than one source file.
+ */
+
+/*
+ * Write an unsigned number seven bits at a time, lowest bits first, with
+ *   the high bit of each byte set if more bytes follow.
+ */
+inline void writeVarint(ostream& out, uint64_t number) {
+    while (number >= 0x80) {
+        out.put(char((number & 0x7f) | 0x80));
+        number >>= 7;
+    }
+    out.put(char(number));
+}
+
+/*
+ * Read a number written by writeVarint.
+ */
+inline uint64_t readVarint(istream& in) {
+    uint64_t number = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = in.get();
+        if (byte == EOF) error("The trace ends in the middle of a record");
+        number |= uint64_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) return number;
+    }
+    error("The trace holds a number that is too long");
+    return 0;
+}
+
+/*
+ * Write the header and then each operation. Differences are zigzag
+ *   encoded, so that small negative ones take as few bytes as small
+ *   positive ones.
+ */
+inline void writeTrace(ostream& out, const Trace& trace) {
+    out.write("PQTR", 4);
+    writeVarint(out, trace.size());
+    long long previous = 0;
+    for (size_t i = 0; i < trace.size(); i++) {
+        if (!trace[i].isEnqueue) {
+            writeVarint(out, 0);
+        } else {
+            uint64_t difference = uint64_t(trace[i].value) - uint64_t(previous);
+            uint64_t zigzag = (difference << 1) ^ (0 - (difference >> 63));
+            if (zigzag == ~uint64_t(0)) error("The trace holds values too far apart to record");
+            writeVarint(out, zigzag + 1);
+            previous = trace[i].value;
+        }
+    }
+    if (!out) error("Could not write the trace");
+}
+
+/*
+ * Read the header and then each operation, keeping count of the values in
+ *   the queue to check that every dequeue finds one.
+ */
+inline Trace readTrace(istream& in) {
+    char magic[4];
+    if (!in.read(magic, 4) || string(magic, 4) != "PQTR") error("The file does not hold a trace");
+    uint64_t numOperations = readVarint(in);
+
+    Trace trace;
+    long long previous = 0;
+    long queueSize = 0;
+    for (uint64_t i = 0; i < numOperations; i++) {
+        uint64_t record = readVarint(in);
+        TraceOperation operation;
+        operation.isEnqueue = (record != 0);
+        operation.value = 0;
+        if (operation.isEnqueue) {
+            uint64_t zigzag = record - 1;
+            uint64_t difference = (zigzag >> 1) ^ (0 - (zigzag & 1));
+            operation.value = (long long)(uint64_t(previous) + difference);
+            previous = operation.value;
+            queueSize++;
+        } else {
+            if (queueSize == 0) error("The trace dequeues from an empty queue");
+            queueSize--;
+        }
+        trace.push_back(operation);
+    }
+    return trace;
+}
+
+/*
+ * Count the values in the queue after each operation.
+ */
+inline int peakSize(const Trace& trace) {
+    int size = 0;
+    int peak = 0;
+    for (size_t i = 0; i < trace.size(); i++) {
+        size += trace[i].isEnqueue ? 1 : -1;
+        peak = max(peak, size);
+    }
+    return peak;
+}
+
+/*
+ * Build the adjacency arrays, starting each vertex's edges with the one to
+ *   the next vertex.
+ */
+inline RandomGraph makeRandomGraph(int numVertices, int degree, int maxWeight, unsigned seed) {
+    if (numVertices < 1 || degree < 1) error("A graph needs at least one vertex and one edge per vertex");
+
+    minstd_rand random(seed);
+    RandomGraph graph;
+    for (int v = 0; v < numVertices; v++) {
+        graph.firstEdge.push_back(graph.target.size());
+        for (int e = 0; e < degree; e++) {
+            int target = (e == 0) ? (v + 1) % numVertices : int(random() % numVertices);
+            graph.target.push_back(target);
+            graph.weight.push_back(1 + int(random() % maxWeight));
+        }
+    }
+    graph.firstEdge.push_back(graph.target.size());
+    return graph;
+}
+
+/*
+ * Fill the queue with values spread over the range the increments cover,
+ *   so that new values land all through the queue rather than at its end.
+ */
+template <typename PQueue>
+double runHoldModel(PQueue& queue, int size, int numOperations, unsigned seed) {
+    const int MAX_INCREMENT = 1000000;
+    minstd_rand random(seed);
+    for (int i = 0; i < size; i++) {
+        queue.enqueue((long long)(random() % MAX_INCREMENT));
+    }
+    vector<int> increments(numOperations);
+    for (int i = 0; i < numOperations; i++) {
+        increments[i] = int(random() % MAX_INCREMENT);
+    }
+
+    long long checksum = 0;
+    Stopwatch stopwatch;
+    for (int i = 0; i < numOperations; i++) {
+        long long value = queue.dequeueMin();
+        checksum += value;
+        queue.enqueue(value + increments[i]);
+    }
+    double seconds = stopwatch.seconds();
+    doNotOptimize(checksum);
+    return seconds;
+}
+
+/*
+ * Run Dijkstra's algorithm with values that hold the distance in their
+ *   high 32 bits and the vertex in their low 32 bits, so that they order
+ *   by distance. An entry is out of date if a shorter distance to its
+ *   vertex has been found since it was enqueued.
+ */
+template <typename PQueue>
+double runDijkstra(PQueue& queue, const RandomGraph& graph, long& numOperations, long long& checksum) {
+    const long long UNREACHED = (1LL << 31) - 1;
+    vector<long long> distance(graph.numVertices(), UNREACHED);
+    numOperations = 0;
+
+    Stopwatch stopwatch;
+    distance[0] = 0;
+    queue.enqueue(0LL);
+    numOperations++;
+    while (!queue.isEmpty()) {
+        long long entry = queue.dequeueMin();
+        numOperations++;
+        long long dist = entry >> 32;
+        int vertex = int(entry & 0xffffffffLL);
+        if (dist > distance[vertex]) continue;
+        for (int e = graph.firstEdge[vertex]; e < graph.firstEdge[vertex + 1]; e++) {
+            int target = graph.target[e];
+            long long newDistance = dist + graph.weight[e];
+            if (newDistance < distance[target]) {
+                distance[target] = newDistance;
+                queue.enqueue((newDistance << 32) | target);
+                numOperations++;
+            }
+        }
+    }
+    double seconds = stopwatch.seconds();
+
+    checksum = 0;
+    for (size_t v = 0; v < distance.size(); v++) {
+        checksum += distance[v];
+    }
+    return seconds;
+}
+
+/*
+ * Apply each operation of the trace in turn. readTrace has already made
+ *   sure that no dequeue finds the queue empty.
+ */
+template <typename PQueue>
+double replayTrace(PQueue& queue, const Trace& trace) {
+    long long checksum = 0;
+    Stopwatch stopwatch;
+    for (size_t i = 0; i < trace.size(); i++) {
+        if (trace[i].isEnqueue) {
+            queue.enqueue(trace[i].value);
+        } else {
+            checksum += queue.dequeueMin();
+        }
+    }
+    double seconds = stopwatch.seconds();
+    doNotOptimize(checksum);
+    return seconds;
+}
+
+#endif
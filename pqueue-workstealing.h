@@ -0,0 +1,455 @@
+/**********************************************
+ * File: pqueue-workstealing.h
+ *
+ * Name: Eric Beach
+ * Section: Dawson Zhou
+ *
+ * A priority queue split into one HeapPriorityQueue per worker thread, for
+ *   pipelines where each thread mostly consumes the work it produces.
+ *
+ * Each worker enqueues into and dequeues from its own heap, so its lock is
+ *   almost never contended and there is no shared root for all threads to
+ *   fight over. A worker whose heap runs empty steals from the worker that
+ *   has the smallest value, taking the best half of its heap in one go with
+ *   dequeueMin(k, out).
+ *
+ * Every worker also publishes the packed key (see pqueue-packedkeys.h) of
+ *   its smallest value, which other threads can read without taking any
+ *   lock. The smallest of them is a global lower bound on the keys in the
+ *   queue. A worker whose own smallest key is above that bound knows its
+ *   local minimum is stale, and steals the values that are better than it
+ *   before going on with its own work. Since the keys are read without
+ *   locks, they may lag behind the heaps by an operation or two; they
+ *   only steer stealing and never decide correctness.
+ */
+#ifndef PQueue_WorkStealing_Included
+#define PQueue_WorkStealing_Included
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <utility>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include "pqueue-heap.h"
+#include "pqueue-packedkeys.h"
+#include "error.h"
+#include "pqueue-stats.h"
+#include "pqueue-memoryusage.h"
+using namespace std;
+
+/* A class representing a priority queue made of one binary heap per
+ * worker. Values are ordered by Compare, which defaults to operator<, and
+ * KeyTraits must have packed keys that agree with it.
+ *
+ * Each worker is identified by a number from 0 to numWorkers() - 1, and
+ * each thread should use a number of its own; threads may share a number,
+ * but then contend for its lock. Values come out of a worker in sorted
+ * order as long as no other worker holds a smaller one, and otherwise
+ * only approximately.
+ *
+ * Stats is a stats policy from pqueue-stats.h, shared with the workers'
+ * heaps. Every value taken in a steal counts as a move.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare = less<ValueType>,
+          typename Stats = NoStats>
+class WorkStealingPriorityQueue : private Stats {
+    static_assert(KeyTraits::IS_PACKED, "WorkStealingPriorityQueue needs key traits with packed keys");
+
+public:
+	/* Constructs a new, empty priority queue with a heap for each of
+	 * numWorkers workers. The default is one worker per core.
+	 */
+	explicit WorkStealingPriorityQueue(int numWorkers = max(1, int(thread::hardware_concurrency())),
+	                                   Compare compare = Compare());
+
+	/* Returns the number of elements in the priority queue. */
+	int size();
+
+	/* Returns whether or not the priority queue is empty. */
+	bool isEmpty();
+
+	/* Returns the number of workers. */
+	int numWorkers();
+
+	/* Enqueues a copy of a value into the given worker's heap. */
+	void enqueue(int worker, const ValueType& value);
+
+	/* Enqueues a value into the given worker's heap, moving it into storage. */
+	void enqueue(int worker, ValueType&& value);
+
+	/* Enqueues a value constructed from the given arguments into the given
+	 * worker's heap.
+	 */
+	template <typename... Args>
+	void emplace(int worker, Args&&... args);
+
+	/* Returns and removes the smallest value the given worker can find,
+	 * stealing from other workers if its own heap is empty or stale.
+	 */
+	ValueType dequeueMin(int worker);
+
+	/* Like dequeueMin(worker), but moves the value into result. Returns
+	 * false, leaving result alone, if every heap is empty.
+	 */
+	bool tryDequeueMin(int worker, ValueType& result);
+
+	/* Removes k values for the given worker, one dequeueMin() at a time,
+	 * and writes them to out. Returns the output iterator one past the last
+	 * value written.
+	 */
+	template <typename OutputIterator>
+	OutputIterator dequeueMin(int worker, int k, OutputIterator out);
+
+	/* Returns whether another worker has published a key smaller than the
+	 * smallest key of the given worker.
+	 */
+	bool isStale(int worker);
+
+	/* Returns the smallest key any worker has published, or EMPTY_KEY if
+	 * they are all empty.
+	 */
+	uint64_t globalLowerBound();
+	static const uint64_t EMPTY_KEY = ~uint64_t(0);
+
+	/* Removes every value from the priority queue. */
+	void clear();
+
+	/* Moves every value of other into this priority queue, leaving other
+	 * empty. The heap of each worker of other is merged into the heap of
+	 * a worker of this queue.
+	 */
+	void merge(WorkStealingPriorityQueue& other);
+
+	/* Returns a snapshot of the stats kept so far by the queue and the
+	 * heaps of all its workers.
+	 */
+	Stats stats();
+
+	/* Returns the bytes the queue and the heaps of all its workers take,
+	 * split into the values and the overhead. The heaps are locked one at a
+	 * time, so the result is only exact if no worker is changing the queue.
+	 */
+	MemoryUsage memoryUsage();
+
+private:
+	// type of the workers' heaps
+	typedef HeapPriorityQueue<ValueType, Compare, 2, false, Stats> Heap;
+
+	// the heap of one worker with its lock and its published key; the
+	//   padding keeps neighbouring workers off each other's cache lines
+	struct Worker {
+		mutex lock;
+		Heap heap;
+		atomic<uint64_t> minKey;
+		char padding[64];
+
+		explicit Worker(Compare compare) : heap(compare), minKey(EMPTY_KEY) {}
+	};
+	vector<unique_ptr<Worker> > workers;
+
+	// number of values in all heaps together
+	atomic<int> numValues;
+
+	// comparator deciding which of two values comes first
+	Compare isLess;
+
+	// get a worker, checking its number
+	Worker& workerAt(int worker);
+
+	// publish the key of a worker's smallest value; its lock must be held
+	void publishMinKey(Worker& worker);
+
+	// move some of the smallest values of the worker with the smallest key
+	//   into the thief's heap, and return whether any were moved
+	bool steal(int thief);
+
+	// disallow copying, since the workers hold locks
+	WorkStealingPriorityQueue(const WorkStealingPriorityQueue&);
+	WorkStealingPriorityQueue& operator=(const WorkStealingPriorityQueue&);
+};
+
+/*************************************************************
+ * Implementation of the WorkStealingPriorityQueue class. Since the class
+ * is a template, the implementation has to be visible in the header.
+ */
+
+/*
+ * Constructor to create a heap for each worker.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::WorkStealingPriorityQueue(int numWorkers, Compare compare)
+    : numValues(0), isLess(compare) {
+    if (numWorkers < 1) error("A work-stealing queue needs at least one worker");
+    for (int i = 0; i < numWorkers; i++) {
+        workers.push_back(unique_ptr<Worker>(new Worker(compare)));
+    }
+}
+
+/*
+ * Return the current size of the queue.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+int WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::size() {
+    return numValues.load();
+}
+
+/*
+ * Return whether the queue is empty.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+bool WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::isEmpty() {
+    return (size() == 0);
+}
+
+/*
+ * Return the number of workers.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+int WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::numWorkers() {
+    return workers.size();
+}
+
+/*
+ * Add a copy of a value to a worker's heap.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+void WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::enqueue(int worker, const ValueType& value) {
+    emplace(worker, value);
+}
+
+/*
+ * Add a value to a worker's heap without copying it.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+void WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::enqueue(int worker, ValueType&& value) {
+    emplace(worker, std::move(value));
+}
+
+/*
+ * Add a value to a worker's heap and publish its new smallest key.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+template <typename... Args>
+void WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::emplace(int worker, Args&&... args) {
+    typename Stats::Timer timer(*this, STATS_ENQUEUE);
+    Worker& own = workerAt(worker);
+    lock_guard<mutex> guard(own.lock);
+    own.heap.emplace(std::forward<Args>(args)...);
+    publishMinKey(own);
+    numValues++;
+}
+
+/*
+ * Remove and return the smallest value the worker can find.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+ValueType WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::dequeueMin(int worker) {
+    ValueType result;
+    if (!tryDequeueMin(worker, result)) error("The queue is empty");
+    return result;
+}
+
+/*
+ * Remove the smallest value of the worker's own heap, first stealing from
+ *   another worker if the heap is empty or its smallest key is stale. The
+ *   steal may lose a race with other thieves, in which case the worker
+ *   tries again as long as there are values anywhere.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+bool WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::tryDequeueMin(int worker, ValueType& result) {
+    typename Stats::Timer timer(*this, STATS_DEQUEUE);
+    Worker& own = workerAt(worker);
+    while (true) {
+        if (isStale(worker) || own.minKey.load(memory_order_relaxed) == EMPTY_KEY) {
+            steal(worker);
+        }
+
+        {
+            lock_guard<mutex> guard(own.lock);
+            if (!own.heap.isEmpty()) {
+                result = own.heap.dequeueMin();
+                publishMinKey(own);
+                numValues--;
+                return true;
+            }
+        }
+        if (numValues.load() == 0) return false;
+        this_thread::yield();
+    }
+}
+
+/*
+ * Remove k values for a worker one at a time.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+template <typename OutputIterator>
+OutputIterator WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::dequeueMin(int worker, int k, OutputIterator out) {
+    if (k < 0 || k > size()) error("Cannot dequeue more values than the queue holds");
+
+    for (int i = 0; i < k; i++) {
+        *out++ = dequeueMin(worker);
+    }
+    return out;
+}
+
+/*
+ * Compare the worker's published key with everyone else's.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+bool WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::isStale(int worker) {
+    uint64_t ownKey = workerAt(worker).minKey.load(memory_order_relaxed);
+    return globalLowerBound() < ownKey;
+}
+
+/*
+ * Find the smallest published key.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+uint64_t WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::globalLowerBound() {
+    uint64_t lowest = EMPTY_KEY;
+    for (size_t i = 0; i < workers.size(); i++) {
+        lowest = min(lowest, workers[i]->minKey.load(memory_order_relaxed));
+    }
+    return lowest;
+}
+
+/*
+ * Remove every value from every heap.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+void WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::clear() {
+    for (size_t i = 0; i < workers.size(); i++) {
+        lock_guard<mutex> guard(workers[i]->lock);
+        numValues -= workers[i]->heap.size();
+        workers[i]->heap.clear();
+        publishMinKey(*workers[i]);
+    }
+}
+
+/*
+ * Merge another queue into this one heap by heap. Both locks are taken
+ *   with std::lock, so two threads merging two queues into each other
+ *   cannot deadlock.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+void WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::merge(WorkStealingPriorityQueue& other) {
+    if (&other == this) return;
+    for (size_t i = 0; i < other.workers.size(); i++) {
+        Worker& target = *workers[i % workers.size()];
+        Worker& source = *other.workers[i];
+        std::lock(target.lock, source.lock);
+        lock_guard<mutex> targetGuard(target.lock, adopt_lock);
+        lock_guard<mutex> sourceGuard(source.lock, adopt_lock);
+        int moved = source.heap.size();
+        target.heap.merge(source.heap);
+        publishMinKey(target);
+        publishMinKey(source);
+        other.numValues -= moved;
+        numValues += moved;
+    }
+}
+
+/*
+ * Get a worker by its number.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+typename WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::Worker&
+WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::workerAt(int worker) {
+    if (worker < 0 || worker >= int(workers.size())) error("No such worker");
+    return *workers[worker];
+}
+
+/*
+ * Publish the key of the smallest value in a worker's heap. A value whose
+ *   key happens to be EMPTY_KEY is published one below it, so that the
+ *   worker is not taken to be empty.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+void WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::publishMinKey(Worker& worker) {
+    uint64_t key = EMPTY_KEY;
+    if (!worker.heap.isEmpty()) {
+        key = min(KeyTraits::key(worker.heap.peek()), EMPTY_KEY - 1);
+    }
+    worker.minKey.store(key, memory_order_relaxed);
+}
+
+/*
+ * Pick the other worker with the smallest published key as the victim,
+ *   and take half of its values, the smallest ones, in one batch. If the
+ *   thief still has values of its own, it only takes those that are
+ *   better than its own smallest. The victim's lock is released before
+ *   the thief's is taken, so no thread ever holds two of them.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+bool WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::steal(int thief) {
+    int victim = -1;
+    uint64_t victimKey = EMPTY_KEY;
+    for (int i = 0; i < int(workers.size()); i++) {
+        uint64_t key = workers[i]->minKey.load(memory_order_relaxed);
+        if (i != thief && key < victimKey) {
+            victim = i;
+            victimKey = key;
+        }
+    }
+    if (victim == -1) return false;
+
+    uint64_t thiefKey = workers[thief]->minKey.load(memory_order_relaxed);
+    vector<ValueType> stolen;
+    {
+        Worker& source = *workers[victim];
+        lock_guard<mutex> guard(source.lock);
+        int numToSteal = (source.heap.size() + 1) / 2;
+        if (thiefKey == EMPTY_KEY) {
+            source.heap.dequeueMin(numToSteal, back_inserter(stolen));
+        } else {
+            while (int(stolen.size()) < numToSteal &&
+                   KeyTraits::key(source.heap.peek()) < thiefKey) {
+                stolen.push_back(source.heap.dequeueMin());
+            }
+        }
+        publishMinKey(source);
+    }
+    if (stolen.empty()) return false;
+    Stats::countMoves(stolen.size());
+
+    Worker& own = *workers[thief];
+    lock_guard<mutex> guard(own.lock);
+    own.heap.enqueueAll(make_move_iterator(stolen.begin()), make_move_iterator(stolen.end()));
+    publishMinKey(own);
+    return true;
+}
+
+/*
+ * Copy the queue's own stats and add the counts of each worker's heap,
+ *   which are atomic and can be read without taking the workers' locks.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+Stats WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::stats() {
+    Stats total(*this);
+    for (size_t i = 0; i < workers.size(); i++) {
+        total.addCounts(workers[i]->heap.stats());
+    }
+    return total;
+}
+
+/*
+ * Add up the workers' heaps, each under its lock, and the workers around
+ *   them.
+ */
+template <typename ValueType, typename KeyTraits, typename Compare, typename Stats>
+MemoryUsage WorkStealingPriorityQueue<ValueType, KeyTraits, Compare, Stats>::memoryUsage() {
+    MemoryUsage total(0, sizeof(*this) + workers.capacity() * sizeof(unique_ptr<Worker>));
+    for (size_t i = 0; i < workers.size(); i++) {
+        lock_guard<mutex> guard(workers[i]->lock);
+        total += workers[i]->heap.memoryUsage();
+        total.overheadBytes += sizeof(Worker) - sizeof(Heap);
+    }
+    return total;
+}
+
+#endif